@@ -0,0 +1,78 @@
+// Job system scaling benchmark: generates the same batch of terrain columns
+// with 1..N threads and reports throughput and speedup.
+#include "core/JobSystem.hpp"
+#include "game/TerrainGenerator.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int COLUMNS_PER_SIDE = 2048;
+const int COLUMNS_PER_BATCH = 4096;
+const int REPEATS = 5;
+
+// Returns the best of REPEATS runs, in seconds
+double runPass(const TerrainGenerator& terrain, std::vector<int>& heights) {
+    double best = 1e9;
+    for (int r = 0; r < REPEATS; r++) {
+        auto start = std::chrono::steady_clock::now();
+
+        JobSystem::ParallelFor(
+            COLUMNS_PER_SIDE * COLUMNS_PER_SIDE,
+            COLUMNS_PER_BATCH,
+            [&](int begin, int end) {
+                for (int i = begin; i < end; i++) {
+                    int x = i % COLUMNS_PER_SIDE;
+                    int z = i / COLUMNS_PER_SIDE;
+                    heights[i] = terrain.GetHeight(x, z);
+                }
+            });
+
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (elapsed.count() < best)
+            best = elapsed.count();
+    }
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int maxThreads = (int)std::thread::hardware_concurrency();
+    if (argc > 1)
+        maxThreads = std::atoi(argv[1]);
+    if (maxThreads < 1)
+        maxThreads = 1;
+
+    TerrainGenerator terrain;
+    std::vector<int> heights(COLUMNS_PER_SIDE * COLUMNS_PER_SIDE);
+    double columns = (double)heights.size();
+
+    std::printf("%-8s %16s %10s\n", "threads", "columns/s", "speedup");
+
+    double baseline = 0.0;
+    for (int threads = 1; threads <= maxThreads; threads++) {
+        // The calling thread helps while it waits, so N threads means N-1
+        // workers. One thread runs every job inline.
+        if (threads > 1)
+            JobSystem::Init(threads - 1);
+        else
+            JobSystem::Shutdown();
+
+        double seconds = runPass(terrain, heights);
+        double throughput = columns / seconds;
+        if (threads == 1)
+            baseline = throughput;
+
+        std::printf(
+            "%-8d %16.0f %9.2fx\n", threads, throughput, throughput / baseline);
+    }
+
+    JobSystem::Shutdown();
+    return 0;
+}
@@ -0,0 +1,493 @@
+// Voxel engine benchmark suite. Runs micro and macro benchmarks over the
+// core library with a fixed world seed and prints one JSON document, so
+// runs can be diffed or tracked for regressions.
+//
+//   --iterations <n>   timed iterations per benchmark (default 20)
+//   --warmup <n>       untimed iterations first (default 3)
+//   --filter <text>    only run benchmarks whose name contains text
+//   --seed <n>         world and RNG seed (default DEFAULT_WORLD_SEED)
+//   --threads <n>      job system threads; 0 runs every job inline
+//   --out <path>       write the JSON there instead of stdout
+#include "core/CommandLine.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Profiler.hpp"
+#include "game/Chunk.hpp"
+#include "game/Player.hpp"
+#include "game/World.hpp"
+#include "game/network/NetworkSession.hpp"
+#include "game/network/PlayerPrediction.hpp"
+#include "game/network/RemotePlayerStore.hpp"
+#include "game/network/Snapshot.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Area used by the world-sized benchmarks (World::Init loads 4x4 chunks)
+const int WORLD_SIDE = 4 * CHUNK_SIZE;
+
+const int WORLD_CHUNKS =
+    (WORLD_SIDE / CHUNK_SIZE) * (WORLD_SIDE / CHUNK_SIZE);
+const int GENERATED_CHUNKS_PER_SIDE = 8;
+const int BLOCK_LOOKUPS = WORLD_SIDE * CHUNK_SIZE * WORLD_SIDE;
+const int COLLISION_PLAYERS = 16;
+const int COLLISION_STEPS = 120;
+const int PREDICTION_STEPS = 120;
+const int PACKET_COUNT = 1024;
+const int PACKET_PLAYERS = 64;
+const int INTERPOLATED_PLAYERS = 1024;
+
+// Results are folded in here so the optimiser can't drop the work
+volatile uint64_t g_Sink = 0;
+
+struct BenchOptions {
+    int iterations = 20;
+    int warmup = 3;
+    int seed = DEFAULT_WORLD_SEED;
+    int threads = 0;
+    std::string filter;
+};
+
+struct BenchResult {
+    std::string name;
+    double itemsPerIteration = 0.0;
+    std::vector<double> samples; // Nanoseconds per iteration
+};
+
+class BenchSuite {
+  public:
+    explicit BenchSuite(const BenchOptions& options) : m_Options(options) {}
+
+    // Times body() once per iteration. items is the work one call does,
+    // used for the throughput figure.
+    void Run(const std::string& name,
+             double items,
+             const std::function<void()>& body) {
+        if (!m_Options.filter.empty() &&
+            name.find(m_Options.filter) == std::string::npos)
+            return;
+
+        std::cerr << "[Bench] " << name << std::endl;
+        for (int i = 0; i < m_Options.warmup; i++)
+            body();
+
+        BenchResult result;
+        result.name = name;
+        result.itemsPerIteration = items;
+        for (int i = 0; i < m_Options.iterations; i++) {
+            Clock::time_point start = Clock::now();
+            body();
+            std::chrono::duration<double, std::nano> elapsed =
+                Clock::now() - start;
+            result.samples.push_back(elapsed.count());
+        }
+        m_Results.push_back(std::move(result));
+    }
+
+    void WriteJson(std::ostream& out) const;
+
+  private:
+    BenchOptions m_Options;
+    std::vector<BenchResult> m_Results;
+};
+
+void BenchSuite::WriteJson(std::ostream& out) const {
+    out << std::fixed << std::setprecision(1);
+    out << "{\n";
+    out << "  \"suite\": \"orix-bench\",\n";
+    out << "  \"seed\": " << m_Options.seed << ",\n";
+    out << "  \"warmup\": " << m_Options.warmup << ",\n";
+    out << "  \"iterations\": " << m_Options.iterations << ",\n";
+    out << "  \"threads\": " << m_Options.threads << ",\n";
+    out << "  \"benchmarks\": [";
+
+    for (size_t r = 0; r < m_Results.size(); r++) {
+        const BenchResult& result = m_Results[r];
+        std::vector<double> sorted = result.samples;
+        std::sort(sorted.begin(), sorted.end());
+
+        double mean = 0.0;
+        for (double s : sorted)
+            mean += s;
+        mean /= sorted.size();
+
+        double variance = 0.0;
+        for (double s : sorted)
+            variance += (s - mean) * (s - mean);
+        double stddev = std::sqrt(variance / sorted.size());
+
+        double median = sorted[sorted.size() / 2];
+        double itemsPerSecond = result.itemsPerIteration * 1e9 / median;
+
+        out << (r == 0 ? "\n" : ",\n");
+        out << "    {\"name\": \"" << result.name << "\", "
+            << "\"iterations\": " << sorted.size() << ", "
+            << "\"items_per_iteration\": " << result.itemsPerIteration
+            << ", "
+            << "\"mean_ns\": " << mean << ", "
+            << "\"median_ns\": " << median << ", "
+            << "\"min_ns\": " << sorted.front() << ", "
+            << "\"max_ns\": " << sorted.back() << ", "
+            << "\"stddev_ns\": " << stddev << ", "
+            << "\"items_per_second\": " << itemsPerSecond << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+// Fresh chunks straight from the generator, no lighting or meshing
+void benchChunkGeneration(BenchSuite& suite, const BenchOptions& options) {
+    TerrainGenerator terrain(options.seed);
+    const int count = GENERATED_CHUNKS_PER_SIDE * GENERATED_CHUNKS_PER_SIDE;
+
+    suite.Run("chunk_generate", count, [&] {
+        for (int i = 0; i < count; i++) {
+            glm::ivec3 origin(i % GENERATED_CHUNKS_PER_SIDE * CHUNK_SIZE,
+                              0,
+                              i / GENERATED_CHUNKS_PER_SIDE * CHUNK_SIZE);
+            auto chunk = std::make_unique<Chunk>(origin, terrain);
+            g_Sink = g_Sink + (uint64_t)chunk->GetBlock(0, 0, 0).type;
+        }
+    });
+}
+
+// Generation, lighting and meshing of the whole starting area
+void benchWorldInit(BenchSuite& suite, const BenchOptions& options) {
+    suite.Run("world_init", WORLD_CHUNKS, [&] {
+        World world(options.seed);
+        world.Init();
+        g_Sink = g_Sink + world.GetChunkCount();
+    });
+}
+
+// Gather + mesh of every chunk, once per mesher mode
+void benchChunkMeshing(BenchSuite& suite, World& world) {
+    const struct {
+        const char* name;
+        MeshMode mode;
+    } modes[] = {
+        {"chunk_mesh_flat", MeshMode::Flat},
+        {"chunk_mesh_ao", MeshMode::AmbientOcclusion},
+    };
+
+    MeshMode previous = Chunk::s_MeshMode;
+    for (const auto& mode : modes) {
+        Chunk::s_MeshMode = mode.mode;
+        suite.Run(mode.name, world.GetChunkCount(), [&] {
+            world.GetChunkPool().ForEach([&](ChunkHandle, Chunk& chunk) {
+                chunk.GenerateMesh(world);
+                g_Sink = g_Sink + chunk.GetVertexCount();
+            });
+        });
+    }
+    Chunk::s_MeshMode = previous;
+}
+
+// Dropping a chunk and loading it back: relighting it and its neighbours,
+// then remeshing all of them
+void benchChunkReload(BenchSuite& suite, World& world) {
+    // Surrounded on every side the flat starting area has
+    const glm::ivec3 origin(CHUNK_SIZE, 0, CHUNK_SIZE);
+
+    suite.Run("chunk_reload", 1, [&] {
+        world.UnloadChunk(origin);
+        world.LoadChunk(origin);
+
+        // Update lands a few meshes per call, and threaded jobs whenever
+        // they finish
+        bool meshing = true;
+        while (meshing) {
+            world.Update(0.0f);
+            meshing = false;
+            world.GetChunkPool().ForEach([&](ChunkHandle, Chunk& chunk) {
+                meshing = meshing || chunk.IsDirty() || chunk.IsMeshPending();
+            });
+        }
+        g_Sink = g_Sink + world.GetChunkCount();
+    });
+}
+
+void benchBlockAccess(BenchSuite& suite,
+                      World& world,
+                      const BenchOptions& options) {
+    suite.Run("world_get_block_sequential", BLOCK_LOOKUPS, [&] {
+        uint64_t solid = 0;
+        for (int x = 0; x < WORLD_SIDE; x++) {
+            for (int y = 0; y < CHUNK_SIZE; y++) {
+                for (int z = 0; z < WORLD_SIDE; z++) {
+                    solid += world.GetBlockAt(x, y, z).IsActive();
+                }
+            }
+        }
+        g_Sink = g_Sink + solid;
+    });
+
+    // Same number of lookups, scattered over the area in a fixed order
+    std::mt19937 rng((uint32_t)options.seed);
+    std::uniform_int_distribution<int> horizontal(0, WORLD_SIDE - 1);
+    std::uniform_int_distribution<int> vertical(0, CHUNK_SIZE - 1);
+    std::vector<glm::ivec3> positions(BLOCK_LOOKUPS);
+    for (glm::ivec3& pos : positions) {
+        pos = glm::ivec3(horizontal(rng), vertical(rng), horizontal(rng));
+    }
+
+    suite.Run("world_get_block_random", BLOCK_LOOKUPS, [&] {
+        uint64_t solid = 0;
+        for (const glm::ivec3& pos : positions) {
+            solid += world.GetBlockAt(pos.x, pos.y, pos.z).IsActive();
+        }
+        g_Sink = g_Sink + solid;
+    });
+}
+
+// Players walking and jumping across the terrain, one fixed step at a time
+void benchPlayerCollision(BenchSuite& suite, World& world) {
+    const float step = 1.0f / 60.0f;
+
+    suite.Run("player_collision_step",
+              COLLISION_PLAYERS * COLLISION_STEPS,
+              [&] {
+                  // Same spawn and heading every iteration so the work is
+                  // identical between runs
+                  std::vector<Player> players(COLLISION_PLAYERS);
+                  for (int i = 0; i < COLLISION_PLAYERS; i++) {
+                      Player& player = players[i];
+                      player.Position = glm::vec3(
+                          8.0f + (i % 4) * CHUNK_SIZE,
+                          20.0f,
+                          8.0f + (i / 4) * CHUNK_SIZE);
+                      player.Yaw = i * (360.0f / COLLISION_PLAYERS);
+                  }
+
+                  PlayerInput input;
+                  input.forward = true;
+                  for (int s = 0; s < COLLISION_STEPS; s++) {
+                      input.jump = s % 30 == 0;
+                      for (Player& player : players) {
+                          player.Update(step, world, input);
+                      }
+                  }
+
+                  for (const Player& player : players) {
+                      g_Sink = g_Sink + (uint64_t)player.Position.y;
+                  }
+              });
+}
+
+// A client running MAX_SENT_COMMANDS steps ahead of the host and corrected
+// on every one, the worst case: each step replays the whole window of
+// unconfirmed inputs before simulating its own
+void benchPrediction(BenchSuite& suite, World& world) {
+    const float step = 1.0f / 60.0f;
+
+    suite.Run("prediction_replay", PREDICTION_STEPS, [&] {
+        Player player;
+        player.Position = glm::vec3(8.0f, 20.0f, 8.0f);
+        PlayerPrediction prediction;
+
+        PlayerInput input;
+        input.forward = true;
+        uint16_t sequence = 0;
+        for (int s = 0; s < MAX_SENT_COMMANDS + PREDICTION_STEPS; s++) {
+            input.jump = s % 30 == 0;
+            player.Yaw = s * 3.0f;
+
+            // The host always puts the player a little to one side
+            uint16_t acked = (uint16_t)(sequence - MAX_SENT_COMMANDS + 1);
+            if (s >= MAX_SENT_COMMANDS) {
+                PlayerCorrectionPacket correction;
+                correction.sequence = acked;
+                correction.position[0] = player.Position.x + 0.5f;
+                correction.position[1] = player.Position.y;
+                correction.position[2] = player.Position.z;
+                for (int i = 0; i < 3; i++)
+                    correction.velocity[i] = 0.0f;
+                correction.grounded = 0;
+                prediction.ApplyCorrection(correction);
+            }
+
+            prediction.Step(player, world, input, step);
+            sequence++;
+        }
+
+        g_Sink = g_Sink + (uint64_t)prediction.GetCorrections() +
+                 (uint64_t)player.Position.y;
+    });
+}
+
+// A player's state at some tick, walking in a circle
+PlayerState packetState(int player, int tick) {
+    float angle = player * 0.1f + tick * 0.01f;
+    glm::vec3 position(player * 4.0f + std::cos(angle) * 20.0f,
+                       20.0f,
+                       std::sin(angle) * 20.0f);
+    return PlayerState::Quantize(position, angle * 57.3f, 0.0f);
+}
+
+// PACKET_PLAYERS clients sending their own snapshot to us as the host,
+// every one acked straight away so the steady state is delta-coded like a
+// live session
+void benchPackets(BenchSuite& suite) {
+    const uint8_t localSlot = 0;
+    NetworkSession::SetLocalSlot(localSlot);
+    NetworkSession::SetHostSlot(localSlot);
+    for (int p = 0; p < PACKET_PLAYERS; p++)
+        NetworkSession::AssignSlot((uint8_t)(p + 1), (uint64_t)(p + 1));
+
+    auto encodeAll = [](std::vector<SnapshotEncoder>& encoders,
+                        std::vector<std::vector<uint8_t>>& packets,
+                        int& tick) {
+        for (int i = 0; i < PACKET_COUNT; i++) {
+            int player = i % PACKET_PLAYERS;
+            uint8_t slot = (uint8_t)(player + 1);
+            SnapshotEncoder& encoder = encoders[player];
+            encoder.Begin((uint32_t)(tick + i / PACKET_PLAYERS) * 33);
+            encoder.Add(slot, packetState(player, tick + i / PACKET_PLAYERS));
+            encoder.Write(slot, localSlot, packets[i]);
+            encoder.Acknowledge(localSlot, encoder.GetSequence());
+        }
+        tick += PACKET_COUNT / PACKET_PLAYERS;
+    };
+
+    std::vector<SnapshotEncoder> encoders(PACKET_PLAYERS);
+    std::vector<std::vector<uint8_t>> packets(PACKET_COUNT);
+    int tick = 0;
+    suite.Run("packet_encode", PACKET_COUNT, [&] {
+        encodeAll(encoders, packets, tick);
+        g_Sink = g_Sink + packets.back().size();
+    });
+
+    // Decoding needs the stream from the start: the first packet of each
+    // player full, the rest deltas
+    std::vector<SnapshotEncoder> fresh(PACKET_PLAYERS);
+    tick = 0;
+    encodeAll(fresh, packets, tick);
+
+    size_t bytes = 0;
+    for (const std::vector<uint8_t>& packet : packets)
+        bytes += packet.size();
+    std::cerr << "[Bench] " << (double)bytes / PACKET_COUNT
+              << " bytes per state packet (uncompressed "
+              << UNCOMPRESSED_STATE_BYTES << ")" << std::endl;
+
+    // The host takes inputs rather than states, so these go straight to
+    // the decoders
+    std::vector<SnapshotDecoder> decoders(PACKET_PLAYERS);
+    suite.Run("packet_decode", PACKET_COUNT, [&] {
+        // Fresh decoders each time, or every pass after the first would
+        // look like a stale duplicate
+        for (SnapshotDecoder& decoder : decoders)
+            decoder.Reset();
+
+        for (const std::vector<uint8_t>& packet : packets) {
+            BitReader reader(packet.data(), packet.size());
+            reader.Read(8);
+            uint8_t sender = (uint8_t)reader.Read(PLAYER_SLOT_BITS);
+            bool newest = false;
+            const Snapshot* snapshot =
+                decoders[sender - 1].Read(reader, newest);
+            if (snapshot)
+                g_Sink = g_Sink + snapshot->entries.size();
+        }
+    });
+
+    // Every client has sent one input, so it is in every snapshot
+    for (int p = 0; p < PACKET_PLAYERS; p++) {
+        PlayerAuthority& authority = NetworkSession::GetAuthority(p + 1);
+        authority.Spawn(packetState(p, 0).GetPosition());
+        InputCommand command;
+        authority.ReceiveCommands(&command, 1);
+    }
+
+    // One host tick: a snapshot of every player, encoded for each client.
+    // Nothing acks, so every one is a full snapshot, the worst case.
+    suite.Run("snapshot_host_tick", PACKET_PLAYERS, [&] {
+        NetworkSession::SendTick();
+    });
+    NetworkSession::Reset();
+    RemotePlayerStore::Clear();
+
+    // A big lobby with a few states buffered each, sampled between two of
+    // them like a normal frame
+    const int bufferedStates = 6;
+    for (int s = 0; s < bufferedStates; s++) {
+        for (int i = 0; i < INTERPOLATED_PLAYERS; i++) {
+            RemotePlayerStore::ApplyState((uint64_t)(i + 1),
+                                          (uint32_t)s * 33,
+                                          glm::vec3(i, 20.0f, -i - s),
+                                          (float)(i % 360 + s),
+                                          0.0f);
+        }
+        RemotePlayerStore::Interpolate(0.033f);
+    }
+
+    // Zero time step so every iteration samples the same moment
+    suite.Run("remote_player_interpolate", INTERPOLATED_PLAYERS, [&] {
+        RemotePlayerStore::Interpolate(0.0f);
+        g_Sink = g_Sink + (uint64_t)RemotePlayerStore::GetPositions()[0].x;
+    });
+    RemotePlayerStore::Clear();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    CommandLine::Parse(argc, argv);
+
+    BenchOptions options;
+    options.iterations = std::max(1, CommandLine::GetInt("--iterations", 20));
+    options.warmup = std::max(0, CommandLine::GetInt("--warmup", 3));
+    options.seed = CommandLine::GetInt("--seed", DEFAULT_WORLD_SEED);
+    options.threads = std::max(0, CommandLine::GetInt("--threads", 0));
+    options.filter = CommandLine::GetString("--filter");
+
+    // Zones would only fill the ring buffers, nothing reads them here
+    Profiler::SetEnabled(false);
+    if (options.threads > 0)
+        JobSystem::Init(options.threads);
+
+    BenchSuite suite(options);
+    benchChunkGeneration(suite, options);
+    benchWorldInit(suite, options);
+
+    {
+        World world(options.seed);
+        world.Init();
+        benchChunkMeshing(suite, world);
+        benchBlockAccess(suite, world, options);
+        benchPlayerCollision(suite, world);
+        benchPrediction(suite, world);
+        benchChunkReload(suite, world);
+    }
+
+    benchPackets(suite);
+
+    JobSystem::Shutdown();
+
+    std::string path = CommandLine::GetString("--out");
+    if (path.empty()) {
+        suite.WriteJson(std::cout);
+        return 0;
+    }
+
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "[Bench] Could not open " << path << std::endl;
+        return 1;
+    }
+    suite.WriteJson(file);
+    std::cerr << "[Bench] Wrote " << path << std::endl;
+    return 0;
+}
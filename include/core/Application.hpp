@@ -3,11 +3,16 @@
 #include <glad/glad.h>
 #include <SDL.h>
 #include <memory>
+#include <vector>
 
 #include "core/StateManager.hpp"
 #include "game/Player.hpp"
 #include "game/World.hpp"
 #include "renderer/Shader.hpp"
+#include "renderer/WorldRenderer.hpp"
+#include "ui/MemoryWindow.hpp"
+#include "ui/NetworkWindow.hpp"
+#include "ui/ProfilerWindow.hpp"
 #include "ui/UIManager.hpp"
 
 enum class GameState {
@@ -27,6 +32,9 @@ class Application {
     World& GetWorld() {
         return m_World;
     }
+    WorldRenderer& GetWorldRenderer() {
+        return m_WorldRenderer;
+    }
     Player& GetPlayer() {
         return m_Player;
     }
@@ -47,6 +55,18 @@ class Application {
         return m_NetworkTickrate;
     }
 
+    // Simulation runs in fixed steps of 1 / rate seconds. Set from
+    // --sim-rate or a replay; the network session steps clients with it.
+    float GetSimulationRate() const {
+        return m_SimulationRate;
+    }
+    void SetSimulationRate(float rate);
+
+    // How far between the last two simulation steps this frame is (0-1)
+    float GetInterpolationAlpha() const {
+        return m_InterpolationAlpha;
+    }
+
     bool IsMouseLocked() const {
         return m_IsMouseLocked;
     }
@@ -61,11 +81,16 @@ class Application {
 
   private:
     bool Initialize();
-    void ProcessEvents();
+    void ProcessEvents(float frameTime);
+    void FixedUpdate(float step);
     void Update(float deltaTime);
     void Render();
     void Cleanup();
 
+    // --record / --replay cover gameplay only, from its first frame
+    void beginInputCapture();
+    void finishReplay();
+
     // Managers
     std::unique_ptr<StateManager> m_StateManager;
     std::unique_ptr<UIManager> m_UIManager;
@@ -88,10 +113,32 @@ class Application {
 
     // World
     World m_World;
+    WorldRenderer m_WorldRenderer;
 
     // Player
     Player m_Player;
-    float m_LastFrame;
+
+    // Frame timing
+    Uint64 m_LastCounter = 0;
+    double m_Accumulator = 0.0;
+    float m_SimulationRate = 60.0f;
+    float m_InterpolationAlpha = 0.0f;
+
+    // After a long stall, drop the backlog instead of spiralling
+    const int m_MaxSimulationSteps = 5;
+
+    // Real frame times (ms) while a --replay runs, reported when it ends
+    bool m_Replaying = false;
+    std::vector<double> m_ReplayFrameTimes;
+
+    // Debug windows (F3 toggles the profiler, F5 the memory budgets, F6
+    // network traffic)
+    ProfilerWindow m_ProfilerWindow;
+    bool m_ShowProfiler = false;
+    MemoryWindow m_MemoryWindow;
+    bool m_ShowMemory = false;
+    NetworkWindow m_NetworkWindow;
+    bool m_ShowNetwork = false;
 
     // Steam lobby ID input
     char m_LobbyIdInput[64] = "";
@@ -11,7 +11,9 @@ class Camera {
     glm::mat4 GetProjectionMatrix(float width, float height) const;
     glm::vec3 GetPosition() const;
 
-    void Update(float deltaTime);
+    // Turns the camera by a mouse movement in pixels
+    void Update(glm::vec2 mouseDelta);
+    void SetRotation(float yaw, float pitch);
 
     glm::vec3 Position;
     glm::vec3 Front;
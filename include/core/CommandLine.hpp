@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Process arguments. Options are written "--name value" or "--name=value".
+class CommandLine {
+  public:
+    static void Parse(int argc, char** argv);
+
+    static bool HasFlag(const std::string& name);
+    static std::string GetString(const std::string& name,
+                                 const std::string& fallback = "");
+    static int GetInt(const std::string& name, int fallback = 0);
+    static float GetFloat(const std::string& name, float fallback = 0.0f);
+
+  private:
+    static bool findValue(const std::string& name, std::string& value);
+
+    inline static std::vector<std::string> m_Args;
+};
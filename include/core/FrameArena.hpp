@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Linear allocator for temporaries that die by the end of the frame. Every
+// thread has its own (Get()), so allocating never locks. The main thread
+// resets its arena at the end of each frame and workers reset theirs
+// after each job.
+//
+// Running out never fails: extra blocks are chained on, and the next
+// Reset() folds them into one block big enough for that peak, so a steady
+// workload stops touching the heap after a frame or two.
+class FrameArena {
+  public:
+    FrameArena() = default;
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* Allocate(size_t size, size_t alignment);
+
+    // Only the most recent allocation is actually given back, which is
+    // enough for a vector growing on top of the arena
+    void Free(void* ptr, size_t size);
+
+    // Invalidates everything allocated since the last reset
+    void Reset();
+
+    size_t GetUsed() const {
+        return m_Used;
+    }
+    size_t GetCapacity() const;
+
+    // Highest GetUsed() seen between two resets
+    size_t GetPeak() const {
+        return m_Peak;
+    }
+
+    // The calling thread's arena
+    static FrameArena& Get();
+
+  private:
+    struct Block {
+        uint8_t* data = nullptr;
+        size_t size = 0;
+    };
+
+    void addBlock(size_t minSize);
+
+    std::vector<Block> m_Blocks;
+    size_t m_Offset = 0; // Into m_Blocks.back()
+    size_t m_Used = 0;
+    size_t m_Peak = 0;
+};
+
+// STL allocator on top of a FrameArena. Containers using it must not live
+// past the arena's next reset.
+template <typename T> class FrameAllocator {
+  public:
+    using value_type = T;
+
+    FrameAllocator() : m_Arena(&FrameArena::Get()) {}
+    explicit FrameAllocator(FrameArena& arena) : m_Arena(&arena) {}
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other) : m_Arena(other.m_Arena) {}
+
+    T* allocate(size_t count) {
+        return (T*)m_Arena->Allocate(count * sizeof(T), alignof(T));
+    }
+    void deallocate(T* ptr, size_t count) {
+        m_Arena->Free(ptr, count * sizeof(T));
+    }
+
+    template <typename U> bool operator==(const FrameAllocator<U>& other) const {
+        return m_Arena == other.m_Arena;
+    }
+    template <typename U> bool operator!=(const FrameAllocator<U>& other) const {
+        return m_Arena != other.m_Arena;
+    }
+
+  private:
+    template <typename U> friend class FrameAllocator;
+    FrameArena* m_Arena;
+};
+
+template <typename T> using FrameVector = std::vector<T, FrameAllocator<T>>;
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "game/Player.hpp"
+#include "game/PlayerInput.hpp"
+#include "game/World.hpp"
+#include "game/network/PacketBatch.hpp"
+#include "game/network/PlayerPrediction.hpp"
+#include "game/network/SimulatedTransport.hpp"
+#include "game/network/Snapshot.hpp"
+#include "game/network/Transport.hpp"
+#include "platform/UdpTransport.hpp"
+#include <csignal>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Runs the simulation with no window, GL context or Steam client, for
+// dedicated servers, soak tests and benchmarks (--headless).
+//
+// A few bots stand in for players: they walk, jump and dig so physics,
+// lighting and the CPU meshing stage stay busy. The server hosts the
+// session and the bots are its clients, so both ends of the protocol run
+// every tick: bots predict their own movement and send inputs, the server
+// simulates them and sends back corrections. Bots reach the server over an
+// in-process loopback, or over real UDP sockets for load tests.
+//
+//   --ticks <n>        stop after n simulation steps (default: run forever)
+//   --bots <n>         number of simulated players (default 4)
+//   --unthrottled      step as fast as possible instead of in real time
+//   --sim-rate <hz>    fixed simulation steps per second (default 60);
+//                      clients and server have to agree on it
+//   --transport <t>    loopback (default) or udp
+//   --port <n>         UDP port to listen on or connect to (default 27015)
+//   --connect <host>   only run UDP bots, joining the server at host
+//
+// Everything sent on either side can be made to suffer a bad network, see
+// NetworkConditions::FromCommandLine; --net-seed picks its dice rolls.
+class HeadlessApplication {
+  public:
+    HeadlessApplication();
+    ~HeadlessApplication();
+
+    int Run();
+
+    // Asks the main loop to stop after the current frame (SIGINT does this)
+    static void RequestStop();
+
+  private:
+    struct Bot {
+        Player player;
+        PlayerInput input;
+        std::mt19937 rng;
+        uint64_t id = 0;
+        uint8_t slot = NO_PLAYER_SLOT; // Until the server lets it in
+        uint8_t hostSlot = NO_PLAYER_SLOT;
+        std::unique_ptr<Transport> transport;
+        UdpTransport* udp = nullptr; // transport, if it is one
+        std::unique_ptr<SimulatedTransport> network; // Around transport
+        PlayerPrediction prediction;
+        SnapshotDecoder decoder;
+        PacketBatch outbox; // Sent to the host on the bot's next tick
+
+        // Steps until the bot picks a new direction / edits a block
+        int nextDecision = 0;
+        int nextEdit = 0;
+
+        // The block it dug last, put back on its next edit
+        bool hasDug = false;
+        glm::ivec3 dugPos = glm::ivec3(0);
+        BlockType dugType = BlockType::Air;
+    };
+
+    bool initialize();
+    void fixedUpdate(float step);
+    void update(float deltaTime);
+    void updateBot(Bot& bot, float step);
+    void editBlock(Bot& bot);
+    void receiveMessages();
+    void sendPositions();
+    void deliverToBot(Bot& bot,
+                      uint8_t sender,
+                      const void* data,
+                      size_t size);
+    void printStats(double elapsed);
+
+    World m_World;
+    std::vector<Bot> m_Bots;
+    std::vector<uint8_t> m_PacketBuffer;
+
+    // The server's end, unless this process only runs bots
+    bool m_Hosting = true;
+    std::unique_ptr<Transport> m_Transport;
+    UdpTransport* m_Udp = nullptr; // m_Transport, if it is one
+    std::unique_ptr<SimulatedTransport> m_Network; // Around m_Transport
+
+    float m_SimulationRate = 60.0f;
+    float m_NetworkTickrate = 30.0f;
+    float m_NetworkTimer = 0.0f;
+    const int m_MaxSimulationSteps = 5;
+
+    int64_t m_TickLimit = 0;
+    int64_t m_Ticks = 0;
+    bool m_Unthrottled = false;
+
+    // Stats since the last report
+    int64_t m_StatsTicks = 0;
+    double m_StatsStepTime = 0.0;
+    int m_StatsEdits = 0;
+    int64_t m_StatsFrames = 0;
+    int64_t m_StatsCorrections = 0; // Total when the last report was made
+    uint64_t m_StatsAllocations = 0;
+
+    inline static volatile std::sig_atomic_t s_StopRequested = 0;
+};
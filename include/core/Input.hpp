@@ -6,7 +6,15 @@
 
 class Input {
   public:
-    static void Update();
+    // Samples SDL, or the next recorded frame while an InputRecorder replay
+    // runs. frameTime is the measured frame time, recorded alongside.
+    static void Update(float frameTime);
+
+    // Frame time to simulate this frame: the measured one, or the recorded
+    // one during a replay
+    static float GetFrameTime() {
+        return m_FrameTime;
+    }
 
     // Keyboard
     static bool IsKeyDown(SDL_Scancode key);
@@ -24,4 +32,13 @@ class Input {
     inline static uint32_t m_MouseState = 0;
     inline static uint32_t m_PrevMouseState = 0;
     inline static glm::vec2 m_MouseDelta = glm::vec2(0.0f);
+    inline static float m_FrameTime = 0.0f;
+
+    // Key state as the recording / replay last saw it. Replays point
+    // m_KeyboardState here instead of at SDL's array.
+    inline static uint8_t m_RecordedKeyboardState[SDL_NUM_SCANCODES];
+    inline static bool m_WasReplaying = false;
+
+    static void recordFrame();
+    static void replayFrame();
 };
\ No newline at end of file
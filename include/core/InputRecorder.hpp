@@ -0,0 +1,66 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Set on a recorded key change when the key went down
+const uint16_t INPUT_KEY_DOWN_BIT = 0x8000;
+
+// Everything one Input::Update saw, plus the frame time it was given.
+// Keys are stored as changes since the previous frame.
+struct InputFrame {
+    float deltaTime = 0.0f;
+    int16_t mouseDeltaX = 0;
+    int16_t mouseDeltaY = 0;
+    uint8_t mouseButtons = 0;
+    std::vector<uint16_t> keyChanges; // Scancode | INPUT_KEY_DOWN_BIT
+};
+
+// Simulation state when the recording started, so a replay begins exactly
+// where the recording did
+struct InputRecordingStart {
+    int seed = 0;
+    float simulationRate = 60.0f;
+    glm::vec3 position = glm::vec3(0.0f);
+    glm::vec3 velocity = glm::vec3(0.0f);
+    float yaw = 0.0f;
+    float pitch = 0.0f;
+    bool grounded = false;
+};
+
+// Compact binary input log: a fixed header with the start state, then
+// 10 bytes per frame plus 2 per key change. Knows nothing about SDL; Input
+// converts to and from its own state.
+class InputRecorder {
+  public:
+    static bool BeginRecording(const std::string& path,
+                               const InputRecordingStart& start);
+    static void RecordFrame(const InputFrame& frame);
+    static void EndRecording();
+    static bool IsRecording() {
+        return m_Output.is_open();
+    }
+
+    static bool BeginReplay(const std::string& path,
+                            InputRecordingStart& start);
+
+    // Reads the next frame; false (and the replay ends) once the file runs
+    // out
+    static bool ReadFrame(InputFrame& frame);
+    static void EndReplay();
+    static bool IsReplaying() {
+        return m_Input.is_open();
+    }
+
+    static int GetFrameCount() {
+        return m_FrameCount;
+    }
+
+  private:
+    inline static std::ofstream m_Output;
+    inline static std::ifstream m_Input;
+    inline static int m_FrameCount = 0;
+};
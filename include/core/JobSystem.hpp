@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Number of jobs still outstanding in a group. Hand one to Run() for every
+// job in the group, then Wait() on it or use it as another job's dependency.
+class JobCounter {
+  public:
+    bool IsDone() const {
+        return m_Count.load(std::memory_order_acquire) == 0;
+    }
+
+  private:
+    friend class JobSystem;
+    std::atomic<int> m_Count{0};
+};
+
+// Engine-wide worker pool. Every thread owns a deque: it pushes and pops
+// its own work at the back and steals from the front of the others when
+// it runs dry. The thread that calls Init() is thread 0 and only runs jobs
+// while it waits.
+class JobSystem {
+  public:
+    // workerCount 0 means one worker per remaining hardware thread
+    static void Init(int workerCount = 0);
+    static void Shutdown();
+
+    static int GetWorkerCount() {
+        return (int)m_Threads.size();
+    }
+
+    // Queues a job. counter, if given, stays non-zero until it finishes.
+    // A job with a dependency doesn't start until that counter is done.
+    static void Run(std::function<void()> job,
+                    JobCounter* counter = nullptr,
+                    const JobCounter* dependency = nullptr);
+
+    // Runs queued jobs on the calling thread until counter is done
+    static void Wait(const JobCounter& counter);
+
+    // Splits [0, count) into batches of batchSize, runs them across all
+    // threads and returns once every batch is done
+    static void ParallelFor(int count,
+                            int batchSize,
+                            const std::function<void(int begin, int end)>& body);
+
+  private:
+    struct Job {
+        std::function<void()> function;
+        JobCounter* counter = nullptr;
+        const JobCounter* dependency = nullptr;
+    };
+
+    // Ring buffer deque. Unlike std::deque it keeps its storage when it
+    // drains, so queueing jobs stops allocating once it's big enough.
+    struct JobQueue {
+        std::mutex mutex;
+        std::vector<Job> ring;
+        size_t head = 0;
+        size_t count = 0;
+
+        void PushBack(Job job);
+        void PushFront(Job job);
+        Job PopBack();
+        Job PopFront();
+
+      private:
+        void grow();
+    };
+
+    static void workerLoop(int index);
+    static bool popJob(int index, Job& job);
+    static bool runOneJob();
+    static void push(int index, Job job, bool front);
+
+    inline static std::vector<std::unique_ptr<JobQueue>> m_Queues;
+    inline static std::vector<std::thread> m_Threads;
+
+    inline static std::mutex m_WakeMutex;
+    inline static std::condition_variable m_WakeCondition;
+    inline static std::atomic<int> m_QueuedJobs{0};
+    inline static std::atomic<bool> m_Stopping{false};
+
+    // Index of the calling thread's queue (0 for the main thread)
+    inline static thread_local int t_ThreadIndex = 0;
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// What tagged memory is spent on. GpuBuffers is VRAM, the rest is RAM.
+enum class MemoryCategory {
+    ChunkVoxels, // Block and light arrays of loaded chunks
+    CpuMesh,     // Chunk section vertices and pooled mesh jobs
+    GpuBuffers,  // Chunk and LOD vertex buffers
+    Noise,       // Terrain noise state
+    Network,     // Remote player state
+    UI,          // ImGui allocations
+    FrameArenas, // Per-thread frame arena blocks
+    Count
+};
+
+const int MEMORY_CATEGORY_COUNT = (int)MemoryCategory::Count;
+
+// Running byte totals per category, tagged by the code that owns the
+// memory, with a peak and a budget each. Add/Remove are lock-free and safe
+// from any thread.
+//
+// A system that can give memory back (streaming, LOD tiles) registers an
+// eviction hook; Update() calls it once a frame while its category is over
+// budget, with how many bytes over it is.
+class MemoryTracker {
+  public:
+    using EvictionHook = std::function<void(int64_t overBudget)>;
+
+    static void Add(MemoryCategory category, int64_t bytes);
+    static void Remove(MemoryCategory category, int64_t bytes) {
+        Add(category, -bytes);
+    }
+
+    static int64_t GetCurrent(MemoryCategory category) {
+        return m_Current[(int)category].load(std::memory_order_relaxed);
+    }
+    static int64_t GetPeak(MemoryCategory category) {
+        return m_Peak[(int)category].load(std::memory_order_relaxed);
+    }
+    static int64_t GetBudget(MemoryCategory category) {
+        return m_Budget[(int)category];
+    }
+    static void SetBudget(MemoryCategory category, int64_t bytes) {
+        m_Budget[(int)category] = bytes;
+    }
+    static bool IsOverBudget(MemoryCategory category) {
+        return GetCurrent(category) > GetBudget(category);
+    }
+
+    static const char* GetName(MemoryCategory category);
+
+    // Main thread only, like Update(). Returns an id for RemoveEvictionHook.
+    static int AddEvictionHook(MemoryCategory category, EvictionHook hook);
+    static void RemoveEvictionHook(int id);
+
+    // Runs the hooks of every category that is over budget
+    static void Update();
+
+  private:
+    struct Hook {
+        int id;
+        MemoryCategory category;
+        EvictionHook function;
+    };
+
+    inline static std::atomic<int64_t> m_Current[MEMORY_CATEGORY_COUNT] = {};
+    inline static std::atomic<int64_t> m_Peak[MEMORY_CATEGORY_COUNT] = {};
+    static int64_t m_Budget[MEMORY_CATEGORY_COUNT];
+
+    inline static std::vector<Hook> m_Hooks;
+    inline static int m_NextHookId = 1;
+};
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// One finished zone. name must be a string literal (or otherwise outlive
+// the profiler).
+struct ProfileEvent {
+    const char* name;
+    uint64_t start; // Nanoseconds, Profiler::Now() clock
+    uint64_t end;
+    uint32_t depth;
+    uint32_t allocations; // Heap allocations inside, nested zones included
+};
+
+// Per-zone call timings over the last stats window
+struct ZoneStats {
+    uint64_t minNs = UINT64_MAX;
+    uint64_t maxNs = 0;
+    uint64_t totalNs = 0;
+    uint64_t allocations = 0;
+    uint32_t calls = 0;
+
+    double AverageNs() const {
+        return calls ? (double)totalNs / calls : 0.0;
+    }
+    double AverageAllocations() const {
+        return calls ? (double)allocations / calls : 0.0;
+    }
+};
+
+// Everything recorded by one thread during one frame
+struct ProfileThreadCapture {
+    std::string threadName;
+    std::vector<ProfileEvent> events;
+};
+
+struct ProfileFrame {
+    uint64_t number = 0;
+    uint64_t start = 0;
+    uint64_t end = 0;
+    std::vector<ProfileThreadCapture> threads;
+
+    // Counter totals for this frame, e.g. draw calls
+    std::vector<std::pair<std::string, int64_t>> counters;
+};
+
+// Scoped-zone CPU profiler. Each thread writes finished zones into its own
+// single-producer ring buffer without locking; the main thread drains all
+// of them once per frame in EndFrame().
+class Profiler {
+  public:
+    static uint64_t Now();
+
+    // Runtime switch; zones cost one relaxed load while disabled
+    static void SetEnabled(bool enabled) {
+        m_Enabled.store(enabled, std::memory_order_relaxed);
+    }
+    static bool IsEnabled() {
+        return m_Enabled.load(std::memory_order_relaxed);
+    }
+
+    // Name shown for the calling thread's lane in the timeline
+    static void SetThreadName(const std::string& name);
+
+    static void BeginFrame();
+    static void EndFrame();
+
+    // Freezes the captured frame so it can be inspected
+    static void SetPaused(bool paused) {
+        m_Paused = paused;
+    }
+    static bool IsPaused() {
+        return m_Paused;
+    }
+
+    static const ProfileFrame& GetLastFrame() {
+        return m_LastFrame;
+    }
+    static const std::map<std::string, ZoneStats>& GetZoneStats() {
+        return m_ShownStats;
+    }
+
+    // Events dropped because a ring buffer was full
+    static uint64_t GetDroppedEvents() {
+        return m_DroppedEvents.load(std::memory_order_relaxed);
+    }
+
+    static void Record(const char* name,
+                       uint64_t start,
+                       uint64_t end,
+                       uint32_t allocations = 0);
+
+    // Adds to a per-frame counter; totals are reset every frame. Safe from
+    // any thread, but meant to be called about once per frame per counter.
+    // Does nothing while disabled.
+    static void AddCounter(const char* name, int64_t value);
+
+    // Called by the global operator new in profiling builds. Zones count
+    // the ones made inside them, and every frame reports the total over
+    // the threads the profiler knows as the "Heap Allocations" counter.
+    // Only touches the calling thread's own state, and nothing at all
+    // while disabled.
+    static void CountAllocation() {
+        if (t_IgnoreAllocations || !IsEnabled())
+            return;
+        t_Allocations++;
+        if (t_Buffer) {
+            // Only this thread writes it, so no read-modify-write needed
+            std::atomic<uint64_t>& count = t_Buffer->allocations;
+            count.store(count.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
+        }
+    }
+
+    // "Heap Allocations" of the last finished frame
+    static uint64_t GetLastFrameAllocations() {
+        return m_LastFrameAllocations;
+    }
+
+    // Zone nesting depth of the calling thread
+    inline static thread_local uint32_t t_Depth = 0;
+
+    // Heap allocations made so far by the calling thread
+    inline static thread_local uint64_t t_Allocations = 0;
+
+  private:
+    static const size_t RING_CAPACITY = 8192;
+
+    struct ThreadBuffer {
+        std::string name;
+        size_t index = 0; // Lane in every captured frame
+        ProfileEvent events[RING_CAPACITY];
+        std::atomic<uint64_t> write{0};
+        std::atomic<uint64_t> read{0};
+
+        // Written by the owning thread, summed up by EndFrame
+        std::atomic<uint64_t> allocations{0};
+        uint64_t reportedAllocations = 0;
+    };
+
+    static ThreadBuffer& threadBuffer();
+    static void releaseThreadBuffer();
+    static void accumulate(const ProfileEvent& event);
+
+    inline static std::atomic<bool> m_Enabled{true};
+    inline static std::atomic<uint64_t> m_DroppedEvents{0};
+
+    // Registration is the only locked path, once per thread. Exited
+    // threads leave their buffer to the next thread that registers, so
+    // restarting the job system doesn't pile up lanes.
+    inline static std::mutex m_ThreadsMutex;
+    inline static std::vector<std::unique_ptr<ThreadBuffer>> m_Threads;
+    inline static std::vector<ThreadBuffer*> m_FreeThreads;
+    inline static thread_local ThreadBuffer* t_Buffer = nullptr;
+
+    inline static std::mutex m_CounterMutex;
+    inline static std::map<std::string, int64_t, std::less<>> m_Counters;
+
+    // The profiler's own bookkeeping isn't what anyone is measuring
+    inline static thread_local bool t_IgnoreAllocations = false;
+    inline static uint64_t m_LastFrameAllocations = 0;
+
+    inline static uint64_t m_FrameNumber = 0;
+    inline static uint64_t m_FrameStart = 0;
+    inline static bool m_Paused = false;
+    inline static ProfileFrame m_LastFrame;
+
+    // Stats are collected over a window of frames, then shown as a whole
+    static const int STATS_WINDOW_FRAMES = 120;
+    inline static int m_StatsFrames = 0;
+    inline static std::map<std::string, ZoneStats> m_CollectingStats;
+    inline static std::map<std::string, ZoneStats> m_ShownStats;
+};
+
+// Times the enclosing scope
+class ProfileZone {
+  public:
+    explicit ProfileZone(const char* name) {
+        if (!Profiler::IsEnabled())
+            return;
+        m_Name = name;
+        m_Start = Profiler::Now();
+        m_Allocations = Profiler::t_Allocations;
+        Profiler::t_Depth++;
+    }
+
+    ~ProfileZone() {
+        if (!m_Name)
+            return;
+        Profiler::t_Depth--;
+        Profiler::Record(m_Name,
+                         m_Start,
+                         Profiler::Now(),
+                         (uint32_t)(Profiler::t_Allocations - m_Allocations));
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+  private:
+    const char* m_Name = nullptr;
+    uint64_t m_Start = 0;
+    uint64_t m_Allocations = 0;
+};
+
+// Builds without ORIX_PROFILING compile every zone out entirely
+#ifdef ORIX_PROFILING
+#define ORIX_PROFILE_CONCAT_INNER(a, b) a##b
+#define ORIX_PROFILE_CONCAT(a, b) ORIX_PROFILE_CONCAT_INNER(a, b)
+#define ORIX_PROFILE_ZONE(name)                                                \
+    ProfileZone ORIX_PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#define ORIX_PROFILE_FUNCTION() ORIX_PROFILE_ZONE(__func__)
+#define ORIX_PROFILE_COUNTER(name, value) Profiler::AddCounter(name, value)
+#else
+#define ORIX_PROFILE_ZONE(name)
+#define ORIX_PROFILE_FUNCTION()
+#define ORIX_PROFILE_COUNTER(name, value)
+#endif
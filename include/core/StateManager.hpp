@@ -13,6 +13,7 @@ class StateManager {
     void PopState();
     void ChangeState(std::unique_ptr<State> state);
 
+    void FixedUpdate(float step);
     void Update(float deltaTime);
     void Render();
 
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "core/Profiler.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Records the next N profiler frames and writes them as Chrome trace-event
+// JSON, which chrome://tracing and Perfetto can open. CPU zones go on one
+// track per thread, GPU passes on their own process, and counters as
+// counter tracks.
+class TraceCapture {
+  public:
+    // An empty path picks a timestamped file name in the working directory
+    static void Begin(int frameCount, const std::string& path = "");
+    static bool IsCapturing() {
+        return m_FramesLeft > 0;
+    }
+
+    // Called by Profiler::EndFrame
+    static void RecordFrame(const ProfileFrame& frame);
+
+    // GPU pass, already placed on the CPU clock (nanoseconds)
+    static void RecordGpuZone(const char* name, uint64_t start, uint64_t end);
+
+  private:
+    struct GpuEvent {
+        const char* name;
+        uint64_t start;
+        uint64_t end;
+    };
+
+    static void write();
+
+    inline static int m_FramesLeft = 0;
+    inline static std::string m_Path;
+    inline static std::vector<ProfileFrame> m_Frames;
+    inline static std::vector<GpuEvent> m_GpuEvents;
+};
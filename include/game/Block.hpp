@@ -6,8 +6,24 @@ enum class BlockType : uint8_t {
     Grass,
     Dirt,
     Stone,
+    Lamp,
 };
 
+// Number of entries in BlockType, used to size per-type tables
+const int BLOCK_TYPE_COUNT = 5;
+
+const int MAX_LIGHT_LEVEL = 15;
+
+// Light level a block emits on its own (0-15)
+inline int GetLightEmission(BlockType type) {
+    return type == BlockType::Lamp ? MAX_LIGHT_LEVEL : 0;
+}
+
+// Opaque blocks stop both sky and block light
+inline bool IsOpaque(BlockType type) {
+    return type != BlockType::Air;
+}
+
 struct Block {
     BlockType type;
 
@@ -17,4 +33,4 @@ struct Block {
     bool IsActive() const {
         return type != BlockType::Air;
     }
-};
\ No newline at end of file
+};
@@ -1,31 +1,160 @@
 #pragma once
 #include "Block.hpp"
-#include "renderer/Shader.hpp"
+#include "ChunkVertex.hpp"
+#include "TerrainGenerator.hpp"
 #include <glm/glm.hpp>
 #include <vector>
 
+class World;
+
+// Custom comparator for glm::ivec3 to use as map key
+struct IVec3Compare {
+    bool operator()(const glm::ivec3& a, const glm::ivec3& b) const {
+        if (a.x != b.x)
+            return a.x < b.x;
+        if (a.y != b.y)
+            return a.y < b.y;
+        return a.z < b.z;
+    }
+};
+
 const int CHUNK_SIZE = 16;
+const int PADDED_CHUNK_SIZE = CHUNK_SIZE + 2;
+
+// Chunks are remeshed in horizontal slabs so a single edit only rebuilds
+// the few layers it can affect
+const int CHUNK_SECTION_HEIGHT = 4;
+const int CHUNK_SECTION_COUNT = CHUNK_SIZE / CHUNK_SECTION_HEIGHT;
+const uint32_t ALL_CHUNK_SECTIONS = (1u << CHUNK_SECTION_COUNT) - 1;
+
+enum class MeshMode {
+    Flat,            // Face culling only
+    AmbientOcclusion // Face culling + per-vertex corner AO
+};
+
+// Block types and light of a chunk plus a one-block border copied from
+// its 26 neighbours, so the mesher never has to leave the array
+struct ChunkNeighbourhood {
+    BlockType blocks[PADDED_CHUNK_SIZE][PADDED_CHUNK_SIZE][PADDED_CHUNK_SIZE];
+    uint8_t light[PADDED_CHUNK_SIZE][PADDED_CHUNK_SIZE][PADDED_CHUNK_SIZE];
+
+    // Local chunk coordinates, valid from -1 to CHUNK_SIZE
+    BlockType Get(int x, int y, int z) const {
+        return blocks[x + 1][y + 1][z + 1];
+    }
+    bool IsSolid(int x, int y, int z) const {
+        return Get(x, y, z) != BlockType::Air;
+    }
+    uint8_t GetLight(int x, int y, int z) const {
+        return light[x + 1][y + 1][z + 1];
+    }
+};
+
+// Output of the CPU meshing stage for the sections set in sectionMask.
+// lodLevel 0 is a real chunk, higher levels are far LOD tiles.
+struct ChunkMeshData {
+    glm::ivec3 origin = glm::ivec3(0);
+    int lodLevel = 0;
+    int skirtDepth = 0; // Skirts are appended to section 0 when > 0
+    uint32_t sectionMask = 0;
+    std::vector<ChunkVertex> sections[CHUNK_SECTION_COUNT];
+};
 
 class Chunk {
   public:
-    Chunk(glm::ivec3 position);
+    // All air until Generate() fills it in
+    explicit Chunk(glm::ivec3 position);
+    Chunk(glm::ivec3 position, const TerrainGenerator& terrain);
     ~Chunk();
 
-    void GenerateMesh();
-    void Render(Shader& shader);
+    // Fills the blocks from the terrain generator. Only reads the
+    // generator, so different chunks can generate in parallel.
+    void Generate(const TerrainGenerator& terrain);
+
+    // Synchronous gather + mesh of every section
+    void GenerateMesh(World& world);
+
+    // Replaces the sections present in data and bumps the mesh version
+    void ApplyMesh(ChunkMeshData& data);
+
+    // CPU mesh of one section. The renderer concatenates all of them into
+    // one buffer whenever GetMeshVersion() changes.
+    const std::vector<ChunkVertex>& GetSection(int section) const {
+        return m_Sections[section];
+    }
+    uint32_t GetMeshVersion() const {
+        return m_MeshVersion;
+    }
 
     void SetBlock(int x, int y, int z, BlockType type);
     Block GetBlock(int x, int y, int z);
 
+    // Packed light byte: sky light in the high nibble, block light low
+    uint8_t GetLight(int x, int y, int z) const {
+        return m_Light[x][y][z];
+    }
+    void SetLight(int x, int y, int z, uint8_t light) {
+        m_Light[x][y][z] = light;
+    }
+
+    // Flags the sections whose mesh can see a change at local layer y.
+    // y may be -1 or CHUNK_SIZE for changes just across the border.
+    void MarkDirty(int y);
+    void MarkAllDirty() {
+        m_DirtySections = ALL_CHUNK_SECTIONS;
+    }
+    bool IsDirty() const {
+        return m_DirtySections != 0;
+    }
+    uint32_t TakeDirtySections() {
+        uint32_t mask = m_DirtySections;
+        m_DirtySections = 0;
+        return mask;
+    }
+
+    // Set while a background mesh job for this chunk is in flight
+    bool IsMeshPending() const {
+        return m_MeshPending;
+    }
+    void SetMeshPending(bool pending) {
+        m_MeshPending = pending;
+    }
+
+    glm::ivec3 GetWorldPos() const {
+        return m_WorldPos;
+    }
+    int GetVertexCount() const;
+
+    // Bytes reserved by the section vectors, which can exceed what the
+    // vertices use
+    size_t GetMeshCapacityBytes() const;
+
+    // Copies this chunk and the bordering blocks of its neighbours
+    void GatherNeighbourhood(World& world, ChunkNeighbourhood& out);
+
+    // CPU meshing stage, independent of GL. Only rebuilds the sections in
+    // out.sectionMask.
+    static void BuildMesh(const ChunkNeighbourhood& blocks,
+                          MeshMode mode,
+                          ChunkMeshData& out);
+
+    // Vertical strips hanging `depth` cells below the outer edge of the
+    // surface. LOD tiles use them to hide cracks against coarser or finer
+    // neighbours.
+    static void BuildSkirts(const ChunkNeighbourhood& blocks,
+                            int depth,
+                            std::vector<ChunkVertex>& out);
+
+    inline static MeshMode s_MeshMode = MeshMode::AmbientOcclusion;
+
   private:
     glm::ivec3 m_WorldPos;
     Block m_Blocks[CHUNK_SIZE][CHUNK_SIZE][CHUNK_SIZE];
+    uint8_t m_Light[CHUNK_SIZE][CHUNK_SIZE][CHUNK_SIZE] = {};
 
-    unsigned int m_VAO, m_VBO;
-    int m_VertexCount;
-
-    void addFace(std::vector<float>& vertices,
-                 glm::vec3 pos,
-                 int faceIndex,
-                 float blockType);
-};
\ No newline at end of file
+    // Mesh of each section, rebuilt independently
+    std::vector<ChunkVertex> m_Sections[CHUNK_SECTION_COUNT];
+    uint32_t m_MeshVersion = 0;
+    uint32_t m_DirtySections = ALL_CHUNK_SECTIONS;
+    bool m_MeshPending = false;
+};
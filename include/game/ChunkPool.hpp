@@ -0,0 +1,89 @@
+#pragma once
+#include "Chunk.hpp"
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Refers to a chunk in a ChunkPool. Once the chunk is destroyed the handle
+// goes stale and Get() returns nullptr, even after the slot is reused.
+struct ChunkHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool IsNull() const {
+        return index == UINT32_MAX;
+    }
+    bool operator==(const ChunkHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const ChunkHandle& other) const {
+        return !(*this == other);
+    }
+};
+
+// Chunk storage in fixed pages of slots. Create and Destroy are O(1) off a
+// free list, freed slots are reused, and chunks never move once created,
+// so Chunk pointers stay valid until Destroy and neighbours loaded
+// together sit next to each other in memory. Main thread only.
+class ChunkPool {
+  public:
+    static const uint32_t CHUNKS_PER_PAGE = 64;
+
+    ChunkPool() = default;
+    ~ChunkPool();
+
+    ChunkPool(const ChunkPool&) = delete;
+    ChunkPool& operator=(const ChunkPool&) = delete;
+
+    // An empty (all air) chunk; fill it with Chunk::Generate
+    ChunkHandle Create(glm::ivec3 position);
+    void Destroy(ChunkHandle handle);
+    void Clear();
+
+    // nullptr if the handle is stale or null
+    Chunk* Get(ChunkHandle handle) const;
+
+    int GetCount() const {
+        return m_Count;
+    }
+    int GetCapacity() const {
+        return (int)(m_Pages.size() * CHUNKS_PER_PAGE);
+    }
+
+    // Calls fn(handle, chunk) for every live chunk, in memory order
+    template <typename Fn> void ForEach(Fn&& fn) const {
+        for (uint32_t p = 0; p < m_Pages.size(); p++) {
+            Slot* page = m_Pages[p].get();
+            for (uint32_t s = 0; s < CHUNKS_PER_PAGE; s++) {
+                if (!page[s].alive)
+                    continue;
+                ChunkHandle handle{p * CHUNKS_PER_PAGE + s, page[s].generation};
+                fn(handle, *page[s].Get());
+            }
+        }
+    }
+
+  private:
+    static const uint32_t NO_SLOT = UINT32_MAX;
+
+    struct Slot {
+        alignas(Chunk) unsigned char storage[sizeof(Chunk)];
+        uint32_t generation = 0;
+        uint32_t nextFree = NO_SLOT;
+        bool alive = false;
+
+        Chunk* Get() {
+            return std::launder(reinterpret_cast<Chunk*>(storage));
+        }
+    };
+
+    Slot& slot(uint32_t index) const {
+        return m_Pages[index / CHUNKS_PER_PAGE][index % CHUNKS_PER_PAGE];
+    }
+    void addPage();
+
+    std::vector<std::unique_ptr<Slot[]>> m_Pages;
+    uint32_t m_FreeHead = NO_SLOT;
+    int m_Count = 0;
+};
@@ -0,0 +1,11 @@
+#pragma once
+#include <cstdint>
+
+// Interleaved chunk vertex: position, UV and a packed attribute word
+struct ChunkVertex {
+    float x, y, z;
+    float u, v;
+    // bits 0-7: BlockType, 8-10: face index, 11-12: AO,
+    // 13-16: sky light, 17-20: block light
+    uint32_t data;
+};
@@ -0,0 +1,74 @@
+#pragma once
+#include "Block.hpp"
+#include <glm/glm.hpp>
+#include <array>
+#include <queue>
+#include <vector>
+
+class Chunk;
+class World;
+
+// Light is stored per voxel as one byte: sky light in the high nibble,
+// block light in the low nibble
+enum class LightChannel {
+    Sky = 0,
+    Block = 1,
+};
+
+// Breadth-first flood fill of sky and block light across chunk borders.
+// Edits only push the changed voxel, so an update touches just the cells
+// whose light actually changes instead of relighting whole chunks.
+class LightEngine {
+  public:
+    explicit LightEngine(World& world);
+
+    // Seeds sky and emitter light for a newly generated chunk and pulls in
+    // light from already lit neighbours. Call Propagate() afterwards.
+    void SeedChunk(Chunk& chunk);
+
+    // Same for a batch of new chunks; the column pass runs on the job
+    // system, one horizontal layer of chunks at a time
+    void SeedChunks(const std::vector<Chunk*>& chunks);
+
+    // Seeds a chunk added next to already lit ones. Columns it now shades
+    // in the chunk below lose their sky light first, which propagates
+    // right away. Call Propagate() afterwards for the rest.
+    void OnChunkLoaded(Chunk& chunk);
+
+    // Queues the light on a chunk's outer faces for removal. Call it just
+    // before the chunk leaves the world and Propagate() once it has; what
+    // its neighbours were lit through it then goes dark.
+    void OnChunkUnloading(Chunk& chunk);
+
+    // Queues the light changes caused by one voxel changing type
+    void OnBlockChanged(glm::ivec3 worldPos,
+                        BlockType oldType,
+                        BlockType newType);
+
+    // Runs the removal queues, then the add queues, until both are empty.
+    // Every cell whose light changes marks the meshes that can see it dirty.
+    void Propagate();
+
+  private:
+    struct LightNode {
+        glm::ivec3 pos;
+        int level;
+    };
+
+    // Per-chunk seeds, indexed by LightChannel
+    using SeedList = std::array<std::vector<LightNode>, 2>;
+
+    bool getLight(glm::ivec3 pos, LightChannel channel, int& level);
+    void setLight(glm::ivec3 pos, LightChannel channel, int level);
+    void removeLight(glm::ivec3 pos, LightChannel channel);
+    void propagateRemoval(LightChannel channel);
+    void propagateAdd(LightChannel channel);
+    void seedColumns(Chunk& chunk, SeedList& seeds);
+    void seedFromBorder(Chunk& chunk);
+
+    World& m_World;
+
+    // Indexed by LightChannel
+    std::queue<LightNode> m_AddQueue[2];
+    std::queue<LightNode> m_RemoveQueue[2];
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include "Chunk.hpp"
+#include "ChunkPool.hpp"
+#include "core/JobSystem.hpp"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// A snapshot of everything the mesher needs, so jobs never touch World
+struct MeshJob {
+    ChunkNeighbourhood blocks;
+    ChunkMeshData mesh; // origin + sectionMask filled in
+    ChunkHandle chunk;  // Stale if it was unloaded meanwhile
+    MeshMode mode = MeshMode::AmbientOcclusion;
+
+    // Section capacity last reported to MemoryTracker, while pooled
+    int64_t trackedBytes = 0;
+};
+
+// Runs the CPU half of chunk meshing on the job system. GL uploads stay
+// on the main thread, which collects finished meshes once per frame.
+//
+// Jobs are pooled: Acquire() one, fill it in, Submit() it, and Recycle()
+// it once its mesh has been used. Section vectors keep their capacity
+// across uses, so steady-state meshing never touches the heap.
+class MeshQueue {
+  public:
+    MeshQueue() = default;
+    ~MeshQueue();
+
+    // Main thread only, like Recycle()
+    MeshJob* Acquire();
+    void Submit(MeshJob* job);
+    void Recycle(MeshJob* job);
+
+    // Moves up to maxResults finished jobs into out
+    void CollectResults(std::vector<MeshJob*>& out, size_t maxResults);
+
+    // Blocks until every submitted job has finished
+    void Flush();
+
+  private:
+    JobCounter m_Pending;
+
+    std::vector<std::unique_ptr<MeshJob>> m_Jobs;
+    std::vector<MeshJob*> m_FreeJobs;
+
+    std::mutex m_ResultMutex;
+    std::vector<MeshJob*> m_Results;
+};
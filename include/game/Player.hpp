@@ -1,6 +1,6 @@
 #pragma once
 #include "core/Camera.hpp"
-#include "core/Input.hpp"
+#include "game/PlayerInput.hpp"
 #include "game/World.hpp"
 #include <glm/glm.hpp>
 
@@ -8,14 +8,22 @@ class Player {
   public:
     Player();
 
-    void Update(float deltaTime, World& world);
-    void UpdateCameraRotation(float deltaTime);
+    // One fixed simulation step. Movement is relative to Yaw.
+    void Update(float deltaTime, World& world, const PlayerInput& input);
+    void UpdateCameraRotation(glm::vec2 mouseDelta);
+
+    // Sets the look direction of both the player and its camera
+    void SetRotation(float yaw, float pitch);
+
+    // Places the camera between the previous and current step
+    void Interpolate(float alpha);
 
     Camera& GetCamera() {
         return m_Camera;
     }
 
     glm::vec3 Position;
+    glm::vec3 PreviousPosition;
     float Yaw = -90.0f;
     float Pitch = 0.0f;
     glm::vec3 Velocity = glm::vec3(0.0f);
@@ -28,5 +36,7 @@ class Player {
 
   private:
     Camera m_Camera;
-    void HandleMovement(float deltaTime, World& world);
+    void HandleMovement(float deltaTime,
+                        World& world,
+                        const PlayerInput& input);
 };
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+
+// Movement intent for one simulation step. The client fills it from the
+// keyboard; headless bots and replays build their own.
+struct PlayerInput {
+    bool forward = false;
+    bool backward = false;
+    bool left = false;
+    bool right = false;
+    bool jump = false;
+};
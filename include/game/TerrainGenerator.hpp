@@ -0,0 +1,30 @@
+#pragma once
+#include "Block.hpp"
+#include "FastNoiseLite.h"
+
+const int DEFAULT_WORLD_SEED = 1337;
+
+// Deterministic height-map terrain. Everything is a pure function of the
+// seed and coordinates, so chunks and far LOD tiles can sample it from any
+// thread and always agree.
+class TerrainGenerator {
+  public:
+    explicit TerrainGenerator(int seed = DEFAULT_WORLD_SEED);
+    ~TerrainGenerator();
+
+    TerrainGenerator(const TerrainGenerator&) = delete;
+    TerrainGenerator& operator=(const TerrainGenerator&) = delete;
+
+    // Number of solid blocks in the column at (x, z)
+    int GetHeight(int worldX, int worldZ) const;
+
+    // Block at height y in a column of the given height
+    static BlockType GetBlockInColumn(int y, int height);
+
+    BlockType GetBlock(int worldX, int worldY, int worldZ) const {
+        return GetBlockInColumn(worldY, GetHeight(worldX, worldZ));
+    }
+
+  private:
+    FastNoiseLite m_Noise;
+};
@@ -1,39 +1,87 @@
 #pragma once
 
-#include "core/Camera.hpp"
-#include "renderer/Shader.hpp"
-
 #include "Chunk.hpp"
+#include "ChunkPool.hpp"
+#include "Lighting.hpp"
+#include "MeshQueue.hpp"
+#include "TerrainGenerator.hpp"
 #include <glm/glm.hpp>
 #include <map>
 
-// Custom comparator for glm::ivec3 to use as map key
-struct IVec3Compare {
-    bool operator()(const glm::ivec3& a, const glm::ivec3& b) const {
-        if (a.x != b.x)
-            return a.x < b.x;
-        if (a.y != b.y)
-            return a.y < b.y;
-        return a.z < b.z;
-    }
-};
-
+// Voxel data, lighting and CPU meshing. Has no GL state; the client draws
+// it through WorldRenderer.
 class World {
   public:
-    World();
+    explicit World(int seed = DEFAULT_WORLD_SEED);
     ~World();
 
     void Init();
     void Update(float deltaTime);
-    void Render(Shader& shader, const Camera& camera, int width, int height);
 
     Block GetBlockAt(int x, int y, int z);
 
+    // Changes a voxel and relights the affected cells. Meshes are only
+    // marked dirty; Update() batches the rebuilds.
+    void SetBlockAt(int x, int y, int z, BlockType type);
+
+    // Marks every chunk section whose mesh reads the voxel at worldPos
+    void MarkDirtyAt(glm::ivec3 worldPos);
+
+    // Steps through voxels along a ray; returns the first solid block and
+    // the normal of the face that was entered
+    bool Raycast(glm::vec3 origin,
+                 glm::vec3 direction,
+                 float maxDistance,
+                 glm::ivec3& hitBlock,
+                 glm::ivec3& hitNormal);
+
+    // Chunk whose origin is chunkOrigin, or nullptr if it isn't loaded
+    Chunk* GetChunk(glm::ivec3 chunkOrigin);
+
+    // Generates and lights a chunk next to whatever is loaded, then
+    // remeshes it and its neighbours. Returns the chunk already there, if
+    // any.
+    Chunk* LoadChunk(glm::ivec3 chunkOrigin);
+
+    // Frees a chunk, takes the light that came through it back out of its
+    // neighbours and remeshes all 26 of them. Outstanding handles to it go
+    // stale, which is how the renderer and in-flight mesh jobs notice.
+    void UnloadChunk(glm::ivec3 chunkOrigin);
+
+    // Origin of the chunk containing a world-space block coordinate
+    static glm::ivec3 ToChunkOrigin(glm::ivec3 worldPos);
+
+    // Every loaded chunk; iterate it with ForEach
+    ChunkPool& GetChunkPool() {
+        return m_ChunkPool;
+    }
+    int GetChunkCount() const {
+        return m_ChunkPool.GetCount();
+    }
+    int GetSeed() const {
+        return m_Seed;
+    }
+    const TerrainGenerator& GetTerrain() const {
+        return m_Terrain;
+    }
+
   private:
-    std::map<glm::ivec3, Chunk*, IVec3Compare> m_Chunks;
+    int m_Seed;
+    TerrainGenerator m_Terrain;
+
+    // Chunks live in the pool; the map only finds them by origin
+    ChunkPool m_ChunkPool;
+    std::map<glm::ivec3, ChunkHandle, IVec3Compare> m_Chunks;
+
+    LightEngine m_Lighting;
+
+    // Dirty chunks are meshed on the job system and applied in Update()
+    MeshQueue m_MeshQueue;
+    std::vector<MeshJob*> m_FinishedMeshes;
+    void scheduleDirtyMeshes();
+    void applyFinishedMeshes();
 
-    // Player cube mesh for rendering remote players
-    unsigned int m_PlayerCubeVAO = 0;
-    unsigned int m_PlayerCubeVBO = 0;
-    void InitPlayerCube();
+    // Every chunk whose mesh reads the one at chunkOrigin: all 26 around
+    // it, since AO and smooth light look across edges and corners too
+    void markNeighboursDirty(glm::ivec3 chunkOrigin);
 };
\ No newline at end of file
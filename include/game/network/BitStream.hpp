@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Packs values of any width from 1 to 32 bits into a byte buffer, lowest
+// bit first. The first 8 bits written land in byte 0 unchanged, so a
+// packet type written first can still be read as a plain byte.
+class BitWriter {
+  public:
+    // Clears buffer and writes into it; reusing one buffer keeps its memory
+    explicit BitWriter(std::vector<uint8_t>& buffer);
+
+    void Write(uint32_t value, int bits);
+    void WriteBool(bool value) {
+        Write(value ? 1 : 0, 1);
+    }
+
+    // Pads the last partial byte. Call once, after the last Write.
+    void Finish();
+
+    size_t GetBitCount() const {
+        return m_BitCount;
+    }
+
+  private:
+    std::vector<uint8_t>& m_Buffer;
+    uint64_t m_Scratch = 0;
+    int m_ScratchBits = 0;
+    size_t m_BitCount = 0;
+};
+
+// Reads back what a BitWriter wrote. Reading past the end returns zeros
+// and sets IsOverflowed(), so callers can check once at the end.
+class BitReader {
+  public:
+    BitReader(const void* data, size_t size);
+
+    uint32_t Read(int bits);
+    bool ReadBool() {
+        return Read(1) != 0;
+    }
+
+    bool IsOverflowed() const {
+        return m_Overflowed;
+    }
+
+  private:
+    const uint8_t* m_Data;
+    size_t m_Size;
+    size_t m_Offset = 0;
+    uint64_t m_Scratch = 0;
+    int m_ScratchBits = 0;
+    bool m_Overflowed = false;
+};
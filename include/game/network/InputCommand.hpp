@@ -0,0 +1,61 @@
+#pragma once
+
+#include "game/PlayerInput.hpp"
+#include "game/network/BitStream.hpp"
+#include <cstdint>
+#include <vector>
+
+class Player;
+class World;
+
+// Commands a predicting client keeps until the host has applied them, and
+// the host keeps until it gets round to applying them
+const int INPUT_HISTORY = 64;
+
+// Most commands one packet carries. Every packet repeats all the commands
+// the host has not confirmed yet, so a lost packet costs nothing.
+const int MAX_SENT_COMMANDS = 32;
+
+// Fixed steps per second a session can run at. Every InputCommands packet
+// says which rate its commands were stepped at, since the host only ever
+// applies them with its own step.
+const int MAX_SIMULATION_RATE = 1000;
+
+// One fixed simulation step of input, numbered so the host can say which
+// it has applied. Look angles are quantised before the client simulates
+// with them, so both ends move along exactly the same direction.
+struct InputCommand {
+    uint16_t sequence = 0;
+    uint8_t buttons = 0; // Forward, backward, left, right, jump from bit 0
+    uint16_t yaw = 0;
+    uint8_t pitch = 0;
+
+    static InputCommand Make(uint16_t sequence,
+                             const PlayerInput& input,
+                             float yaw,
+                             float pitch);
+
+    PlayerInput GetInput() const;
+};
+
+// Moves a player one step by a command. The host and the predicting client
+// both go through here, so the same command from the same state always
+// ends in the same place.
+void SimulateCommand(Player& player,
+                     World& world,
+                     const InputCommand& command,
+                     float step);
+
+// A whole PacketType::InputCommands packet, commands oldest first
+void WriteInputCommands(uint8_t senderSlot,
+                        int simulationRate,
+                        const InputCommand* commands,
+                        int count,
+                        std::vector<uint8_t>& out);
+
+// Reads the sender's simulation rate, which follows type and sender slot
+int ReadInputRate(BitReader& reader);
+
+// Reads the rest of the packet (after the rate) into commands, which must
+// hold MAX_SENT_COMMANDS. Returns how many, or -1 if corrupt.
+int ReadInputCommands(BitReader& reader, InputCommand* commands);
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "game/network/Snapshot.hpp"
+#include "game/network/Transport.hpp"
+#include <vector>
+
+// Peers in the same process. Each endpoint registers under its slot when
+// created; sending to a slot appends to that endpoint's inbox. Nothing is
+// lost or reordered, and steady traffic stops allocating once the inboxes
+// have grown to fit a tick.
+class LoopbackTransport : public Transport {
+  public:
+    explicit LoopbackTransport(uint8_t slot);
+    ~LoopbackTransport() override;
+
+    LoopbackTransport(const LoopbackTransport&) = delete;
+    LoopbackTransport& operator=(const LoopbackTransport&) = delete;
+
+    void Send(uint8_t slot, const void* data, size_t size) override;
+    bool Receive(TransportMessage& message) override;
+
+    uint8_t GetSlot() const {
+        return m_Slot;
+    }
+
+  private:
+    // Messages back to back, each after its 32-bit length and the slot
+    // that sent it
+    void append(uint8_t sender, const void* data, size_t size);
+
+    uint8_t m_Slot;
+    std::vector<uint8_t> m_Inbox;
+
+    // What Receive is working through. Anything sent meanwhile goes to
+    // m_Inbox, so the message handed out is never moved under the caller.
+    std::vector<uint8_t> m_Reading;
+    size_t m_ReadOffset = 0;
+
+    inline static LoopbackTransport* s_Endpoints[MAX_SESSION_PLAYERS] = {};
+};
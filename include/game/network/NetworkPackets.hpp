@@ -1,27 +1,33 @@
 #pragma once
-#include <steam/steam_api.h>
-#include <glm/glm.hpp>
+#include <cstdint>
 
 enum class PacketType : uint8_t {
-    PlayerPosition = 0
+    PlayerState = 0, // Bit-packed snapshot, see Snapshot.hpp
+    StateAck,
+    InputCommands,    // Client to host, see InputCommand.hpp
+    PlayerCorrection, // Host to client: where its inputs really put it
+    Count // Not a packet; size of the dispatch table
 };
 
+// What one player's state cost before snapshots: type, 64-bit Steam ID and
+// five floats, sent in full every tick. Kept for the network stats.
+const int UNCOMPRESSED_STATE_BYTES = 1 + 8 + 5 * 4;
+
 #pragma pack(push, 1)
-struct PlayerPositionPacket {
-    PacketType type = PacketType::PlayerPosition;
-    uint64_t steamID;
-    float x, y, z;
-    float bodyYaw;
-    float headPitch;
+// Tells a sender which of its snapshots arrived, so it can delta against it
+struct StateAckPacket {
+    PacketType type = PacketType::StateAck;
+    uint8_t slot;      // Of the player acknowledging
+    uint16_t sequence; // Newest snapshot received
 };
-#pragma pack(pop)
 
-// Remote player data for interpolation
-struct RemotePlayerData {
-    glm::vec3 currentPos; // Smoothly interpolated position
-    glm::vec3 targetPos;  // Latest received position
-    float yaw;
-    float pitch;
-    float targetYaw;
-    float targetPitch;
-};
\ No newline at end of file
+// The host's result of simulating a client's inputs, sent back to that
+// client only. Full precision, so a prediction that agrees matches exactly.
+struct PlayerCorrectionPacket {
+    PacketType type = PacketType::PlayerCorrection;
+    uint16_t sequence; // Newest input command the host has applied
+    float position[3];
+    float velocity[3];
+    uint8_t grounded;
+};
+#pragma pack(pop)
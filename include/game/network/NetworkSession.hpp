@@ -0,0 +1,163 @@
+#pragma once
+
+#include "game/network/NetworkPackets.hpp"
+#include "game/network/PacketBatch.hpp"
+#include "game/network/PlayerAuthority.hpp"
+#include "game/network/PlayerPrediction.hpp"
+#include "game/network/Snapshot.hpp"
+#include "game/network/Transport.hpp"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class World;
+
+// The multiplayer protocol, independent of any transport: the slot table,
+// snapshot encoding and decoding, and per-peer send batches. Messages go
+// out and come in through whichever Transport it was given, and what they
+// say ends up in RemotePlayerStore.
+//
+// The lobby owner is the host, and the only one who decides where anyone
+// is. Clients send the host their input commands, predicting their own
+// movement meanwhile; the host applies them to its own copies of their
+// players. Every network tick the host sends each client one snapshot
+// with every player in it, plus a correction for that client's own
+// player. Traffic is one packet per client per tick each way instead of
+// every peer sending to every other peer.
+class NetworkSession {
+  public:
+    // Applies every message waiting on the transport; returns how many
+    static int Receive();
+
+    // Applies one received message: a batch of length-prefixed packets.
+    // sender is the slot the transport says it came from; handlers trust
+    // that, not whatever slot a packet claims.
+    static void HandleMessage(uint8_t sender, const void* data, size_t size);
+
+    // Applies one packet. The first byte picks the handler out of a table;
+    // unknown types, short packets and unknown senders are dropped.
+    static void HandlePacket(uint8_t sender, const void* data, size_t size);
+
+    // Every peer mirrors the owner's slot table. Reassigning or releasing a
+    // slot drops whatever was known about its old player.
+    static void AssignSlot(uint8_t slot, uint64_t playerID);
+    static void ReleaseSlot(uint8_t slot);
+    static int FindSlot(uint64_t playerID); // -1 if it has none
+    static uint64_t GetSlotPlayer(uint8_t slot) {
+        return m_SlotPlayers[slot];
+    }
+
+    static void SetLocalSlot(uint8_t slot) {
+        m_LocalSlot = slot;
+    }
+    static uint8_t GetLocalSlot() {
+        return m_LocalSlot;
+    }
+    static void SetHostSlot(uint8_t slot) {
+        m_HostSlot = slot;
+    }
+    static uint8_t GetHostSlot() {
+        return m_HostSlot;
+    }
+    static bool IsHost() {
+        return m_LocalSlot != NO_PLAYER_SLOT && m_LocalSlot == m_HostSlot;
+    }
+
+    // The host's own player's latest state, sent on the next tick
+    static void SetLocalState(glm::vec3 position, float yaw, float pitch);
+
+    // Predicts the local player on a client; every fixed step goes through
+    // it, in a session or not
+    static PlayerPrediction& GetPrediction() {
+        return m_Prediction;
+    }
+
+    // The host's copy of a client's player
+    static PlayerAuthority& GetAuthority(uint8_t slot) {
+        return m_Authorities[slot];
+    }
+
+    // Fixed steps per second, as the application runs them. The host
+    // ignores input from clients that step at any other rate.
+    static void SetSimulationRate(int rate) {
+        m_SimulationRate = rate;
+    }
+    static int GetSimulationRate() {
+        return m_SimulationRate;
+    }
+
+    // Once per fixed step: moves the session clock on, and on the host
+    // applies the clients' queued input commands
+    static void SimulateClients(World& world, float step);
+
+    // Once per network tick: the host sends everyone's state and a
+    // correction to each client, a client sends its unconfirmed commands to
+    // the host. Then every batch, acks included, is flushed.
+    static void SendTick();
+
+    // Sends every non-empty batch now
+    static void Flush();
+
+    // Simulation time snapshots are stamped with, in ms: the fixed steps
+    // SimulateClients has seen. Receivers interpolate against their own
+    // frame time, so the two keep pace however fast the loop really runs.
+    // Only differences between two stamps from the same peer mean anything.
+    static uint32_t GetTime();
+
+    // Batches go out and messages come in through this; without one,
+    // nothing does. Not owned.
+    static void SetTransport(Transport* transport) {
+        m_Transport = transport;
+    }
+    static Transport* GetTransport() {
+        return m_Transport;
+    }
+
+    // Forgets every slot and peer, e.g. after leaving a lobby
+    static void Reset();
+
+  private:
+    struct PacketHandler {
+        void (*handle)(uint8_t sender, const void* data, size_t size);
+        size_t size; // Smallest packet the handler accepts
+    };
+    static const PacketHandler s_Handlers[(size_t)PacketType::Count];
+
+    static void handlePlayerState(uint8_t sender,
+                                  const void* data,
+                                  size_t size);
+    static void handleStateAck(uint8_t sender, const void* data, size_t size);
+    static void handleInputCommands(uint8_t sender,
+                                    const void* data,
+                                    size_t size);
+    static void handlePlayerCorrection(uint8_t sender,
+                                       const void* data,
+                                       size_t size);
+
+    static void queue(uint8_t slot, const void* data, size_t size, int states);
+    static void sendSnapshot(uint8_t slot, int states);
+
+    inline static uint64_t m_SlotPlayers[MAX_SESSION_PLAYERS] = {};
+    inline static uint8_t m_LocalSlot = NO_PLAYER_SLOT;
+    inline static uint8_t m_HostSlot = NO_PLAYER_SLOT;
+
+    // Newest state of each player, ours included; what the host sends out
+    inline static PlayerState m_States[MAX_SESSION_PLAYERS];
+    inline static bool m_HasState[MAX_SESSION_PLAYERS] = {};
+    inline static bool m_WrongRate[MAX_SESSION_PLAYERS] = {}; // Reported
+
+    inline static SnapshotEncoder m_Encoder;
+    inline static SnapshotDecoder m_Decoders[MAX_SESSION_PLAYERS];
+
+    inline static PlayerPrediction m_Prediction;
+    inline static PlayerAuthority m_Authorities[MAX_SESSION_PLAYERS];
+
+    inline static PacketBatch m_Batches[MAX_SESSION_PLAYERS];
+    inline static std::vector<uint8_t> m_PacketBuffer;
+
+    inline static Transport* m_Transport = nullptr;
+
+    inline static int m_SimulationRate = 60;
+    inline static double m_Clock = 0.0; // Seconds of simulation
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Per-second traffic rates
+struct NetworkRates {
+    float bytesSent = 0.0f;
+    float bytesReceived = 0.0f;
+    float packetsSent = 0.0f;
+    float packetsReceived = 0.0f;
+
+    // Player states inside those packets
+    float statesSent = 0.0f;
+    float statesReceived = 0.0f;
+};
+
+// Counts what NetworkSession sends and receives and turns it into rates
+// once a second, for the network window and the headless stats line
+class NetworkStats {
+  public:
+    static void CountSent(size_t bytes, int states);
+    static void CountReceived(size_t bytes, int states);
+
+    // Main thread, once a frame
+    static void Update();
+
+    // Rates over the last full second
+    static const NetworkRates& GetRates() {
+        return m_Rates;
+    }
+
+    static void Reset();
+
+  private:
+    inline static NetworkRates m_Window;
+    inline static NetworkRates m_Rates;
+    inline static uint64_t m_WindowStart = 0;
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Batches stay under this so they go out as one datagram
+const size_t MAX_BATCH_BYTES = 1200;
+
+// Small packets for one peer, coalesced Nagle-style into one message. Each
+// packet is prefixed with its 16-bit length; the batch is sent when the
+// next packet would not fit, or when the session flushes at the end of a
+// network tick.
+class PacketBatch {
+  public:
+    // False if the packet would push a non-empty batch past
+    // MAX_BATCH_BYTES; send the batch and add it again. A packet that is
+    // too big on its own still goes in an empty batch.
+    bool Add(const void* data, size_t size);
+
+    void Clear() {
+        m_Data.clear();
+    }
+    bool IsEmpty() const {
+        return m_Data.empty();
+    }
+    const uint8_t* GetData() const {
+        return m_Data.data();
+    }
+    size_t GetSize() const {
+        return m_Data.size();
+    }
+
+    // Calls handle(data, size) for each packet in a received batch. Stops
+    // and returns false at the first malformed length.
+    template <typename Handler>
+    static bool ForEach(const void* data, size_t size, Handler&& handle) {
+        const uint8_t* bytes = (const uint8_t*)data;
+        size_t offset = 0;
+        while (offset < size) {
+            if (size - offset < 2)
+                return false;
+            size_t length = bytes[offset] | (size_t)bytes[offset + 1] << 8;
+            offset += 2;
+            if (length == 0 || length > size - offset)
+                return false;
+            handle(bytes + offset, length);
+            offset += length;
+        }
+        return true;
+    }
+
+  private:
+    std::vector<uint8_t> m_Data;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "game/Player.hpp"
+#include "game/network/InputCommand.hpp"
+#include "game/network/NetworkPackets.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+
+class World;
+
+// The host's copy of one client's player, moved only by that client's
+// input commands. Commands queue up as they arrive and are applied one per
+// step, at most as many as the host's own clock has paid for, so a client
+// can send whatever it likes and still only walk as fast as the rules say.
+class PlayerAuthority {
+  public:
+    PlayerAuthority();
+
+    // Forgets every command and puts the player back at position
+    void Spawn(glm::vec3 position);
+
+    // Queues the commands the host has not seen yet
+    void ReceiveCommands(const InputCommand* commands, int count);
+
+    // One host step: earns a step's worth of time and spends it on queued
+    // commands. Commands that never arrived are skipped, which the client
+    // finds out about from the next correction.
+    void Simulate(World& world, float step);
+
+    // The result of the newest applied command, once per change
+    bool TakeCorrection(PlayerCorrectionPacket& correction);
+
+    // True once the client has sent anything
+    bool IsActive() const {
+        return m_HasReceived;
+    }
+    const Player& GetPlayer() const {
+        return m_Player;
+    }
+
+    // Commands waiting for the clock, and ones skipped or thrown away
+    int GetQueued() const {
+        return m_HasReceived ? (uint16_t)(m_Received - m_Applied) : 0;
+    }
+    int64_t GetDropped() const {
+        return m_Dropped;
+    }
+
+  private:
+    Player m_Player;
+    InputCommand m_Queue[INPUT_HISTORY];
+    uint16_t m_Received = 0; // Newest command that arrived
+    uint16_t m_Applied = 0;  // Newest command applied or skipped
+    bool m_HasReceived = false;
+    bool m_Changed = false;
+    int m_Credit = 0; // Steps the client may still take
+    int64_t m_Dropped = 0;
+};
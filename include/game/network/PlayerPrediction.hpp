@@ -0,0 +1,77 @@
+#pragma once
+
+#include "game/network/InputCommand.hpp"
+#include "game/network/NetworkPackets.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class Player;
+class World;
+
+// The client's half of client-side prediction. Every step turns the input
+// into a numbered command and simulates it straight away, so movement
+// never waits for the host. The commands go to the host, which applies
+// them to its own copy of the player and reports where each one really
+// left it. If that disagrees with what was predicted for the same
+// command, the player is put where the host says and every command since
+// is simulated again on top.
+class PlayerPrediction {
+  public:
+    // One fixed step of the local player. Reconciles with the newest
+    // correction first, if one came in since the last step.
+    void Step(Player& player,
+              World& world,
+              const PlayerInput& input,
+              float step);
+
+    // Kept until the next Step; a newer correction replaces it
+    void ApplyCorrection(const PlayerCorrectionPacket& correction);
+
+    // Writes an InputCommands packet with every command the host has not
+    // confirmed yet, stepped at simulationRate. False if there are none.
+    bool WriteCommands(uint8_t senderSlot,
+                       int simulationRate,
+                       std::vector<uint8_t>& out) const;
+
+    void Reset();
+
+    // Commands sent but not yet confirmed, roughly round trip / step
+    int GetUnacknowledged() const;
+
+    // Corrections that disagreed with the prediction, and by how far the
+    // last one moved the player
+    int64_t GetCorrections() const {
+        return m_Corrections;
+    }
+    float GetLastError() const {
+        return m_LastError;
+    }
+
+  private:
+    struct Entry {
+        InputCommand command;
+
+        // Where the command left the player
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::vec3 velocity = glm::vec3(0.0f);
+        bool grounded = false;
+    };
+
+    void reconcile(Player& player, World& world);
+    void simulate(Entry& entry, Player& player, World& world);
+
+    Entry m_History[INPUT_HISTORY];
+    uint16_t m_Sequence = 0; // Newest command
+    int m_Count = 0;         // Commands in m_History
+
+    uint16_t m_Acked = 0; // Newest command the host has applied
+    bool m_HasAcked = false;
+
+    PlayerCorrectionPacket m_Correction;
+    bool m_HasCorrection = false;
+    float m_Step = 0.0f;
+
+    int64_t m_Corrections = 0;
+    float m_LastError = 0.0f;
+};
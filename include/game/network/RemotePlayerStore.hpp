@@ -0,0 +1,134 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Received states kept per player. At 30 Hz this is about half a second,
+// well past the interpolation delay.
+const int STATE_BUFFER_SIZE = 16;
+
+// Latest state of every other player, filled in by NetworkSession as
+// snapshots arrive.
+//
+// Players are stored as parallel arrays indexed 0..GetCount()-1, so
+// interpolation and rendering walk flat memory, plus a Steam ID -> index
+// hash so each update costs one lookup. Removing a player moves the last one
+// into its slot; indices are only stable until the next Remove/Clear.
+//
+// Each player keeps a short buffer of timestamped states and is drawn a
+// fixed delay in the past, between the two states around that time. When
+// packets run late the last motion is carried on for a bounded time.
+class RemotePlayerStore {
+  public:
+    // Buffers a player's state, adding the player if it is new. timeMs is
+    // the sender's simulation time when it sent the state; states older
+    // than the newest one buffered are dropped.
+    static void ApplyState(uint64_t steamID,
+                           uint32_t timeMs,
+                           glm::vec3 position,
+                           float yaw,
+                           float pitch);
+
+    // Advances the local clock and samples every player's buffer.
+    // deltaTime has to be simulated time, the same kind senders stamp.
+    static void Interpolate(float deltaTime);
+
+    // A player left; unknown IDs are ignored
+    static void Remove(uint64_t steamID);
+
+    static int GetAndResetPacketCount();
+    static void Clear();
+
+    static int GetCount() {
+        return (int)m_Ids.size();
+    }
+    static const std::vector<uint64_t>& GetIds() {
+        return m_Ids;
+    }
+
+    // Smoothed state, what gets drawn
+    static const std::vector<glm::vec3>& GetPositions() {
+        return m_Positions;
+    }
+    static const std::vector<float>& GetYaws() {
+        return m_Yaws;
+    }
+    static const std::vector<float>& GetPitches() {
+        return m_Pitches;
+    }
+
+    // How far in the past players are drawn. Longer hides more jitter and
+    // loss, shorter shows them closer to where they are.
+    static void SetInterpolationDelay(float seconds) {
+        m_InterpolationDelay = seconds;
+    }
+    static float GetInterpolationDelay() {
+        return m_InterpolationDelay;
+    }
+
+    // Buffered states still ahead of the drawn time, averaged over players
+    // in the last Interpolate
+    static float GetAverageBufferDepth() {
+        return m_AverageBufferDepth;
+    }
+
+    // Players being extrapolated in the last Interpolate
+    static int GetExtrapolatingCount() {
+        return m_ExtrapolatingCount;
+    }
+
+    // States that arrived after the time they should have been drawn at,
+    // since the last Clear
+    static int64_t GetLateStates() {
+        return m_LateStates;
+    }
+
+  private:
+    // Ring of received states, oldest first from next - count
+    struct StateBuffer {
+        double times[STATE_BUFFER_SIZE];
+        glm::vec3 positions[STATE_BUFFER_SIZE];
+        float yaws[STATE_BUFFER_SIZE];
+        float pitches[STATE_BUFFER_SIZE];
+        uint32_t next = 0;
+        uint32_t count = 0;
+    };
+
+    static void add(uint64_t steamID, glm::vec3 position);
+    static void sample(uint32_t i, double now);
+
+    inline static std::vector<uint64_t> m_Ids;
+    inline static std::vector<glm::vec3> m_Positions;
+    inline static std::vector<float> m_Yaws;
+    inline static std::vector<float> m_Pitches;
+    inline static std::vector<StateBuffer> m_Buffers;
+
+    // Local clock minus sender clock, as low as it has been seen
+    inline static std::vector<double> m_ClockOffsets;
+
+    // The two states to blend between for each player, picked by sample()
+    // and blended in one flat pass
+    inline static std::vector<glm::vec3> m_FromPositions;
+    inline static std::vector<glm::vec3> m_ToPositions;
+    inline static std::vector<float> m_FromYaws;
+    inline static std::vector<float> m_ToYaws;
+    inline static std::vector<float> m_FromPitches;
+    inline static std::vector<float> m_ToPitches;
+    inline static std::vector<float> m_Blends;
+
+    inline static std::unordered_map<uint64_t, uint32_t> m_Index;
+
+    inline static double m_Now = 0.0;
+    inline static float m_InterpolationDelay = 0.1f;
+
+    inline static float m_AverageBufferDepth = 0.0f;
+    inline static int m_ExtrapolatingCount = 0;
+    inline static int m_BufferDepthTotal = 0;
+    inline static int64_t m_LateStates = 0;
+
+    // States applied since the last GetAndResetPacketCount()
+    inline static int s_PacketsReceivedThisSecond = 0;
+};
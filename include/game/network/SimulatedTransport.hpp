@@ -0,0 +1,94 @@
+#pragma once
+
+#include "game/network/Snapshot.hpp"
+#include "game/network/Transport.hpp"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// How bad a simulated connection is. Applied to what this process sends,
+// so a round trip through two simulators pays the latency twice.
+struct NetworkConditions {
+    float latencyMs = 0.0f;        // One way
+    float jitterMs = 0.0f;         // Latency varies by up to this either way
+    float lossPercent = 0.0f;      // Messages never sent
+    float duplicatePercent = 0.0f; // Messages sent twice
+    float reorderPercent = 0.0f;   // Messages held back past later ones
+
+    bool IsIdeal() const {
+        return latencyMs <= 0.0f && jitterMs <= 0.0f && lossPercent <= 0.0f &&
+               duplicatePercent <= 0.0f && reorderPercent <= 0.0f;
+    }
+
+    // --latency, --jitter, --loss, --duplicate and --reorder, in ms and %
+    static NetworkConditions FromCommandLine();
+};
+
+struct NetworkSimulationStats {
+    int64_t sent = 0;
+    int64_t dropped = 0;
+    int64_t duplicated = 0;
+    int64_t reordered = 0;
+    int inFlight = 0; // Held back, waiting for their delivery time
+};
+
+// Wraps another transport and makes its connection worse on purpose, so
+// interpolation and prediction can be tuned against a reproducible bad
+// network. Outgoing messages are dropped, duplicated or held back per
+// destination slot, and handed to the real transport once due. Due
+// messages go out whenever Send or Receive runs. With ideal conditions
+// every message goes straight through.
+//
+// Random choices come from a seeded generator, so the same seed drops and
+// duplicates the same messages; delivery times still follow the clock.
+class SimulatedTransport : public Transport {
+  public:
+    // inner must outlive this
+    explicit SimulatedTransport(Transport& inner, uint32_t seed = 1);
+
+    // For every slot without conditions of its own
+    void SetConditions(const NetworkConditions& conditions);
+    const NetworkConditions& GetConditions() const {
+        return m_Conditions;
+    }
+
+    // Per connection; ClearConditions puts the slot back on the default
+    void SetConditions(uint8_t slot, const NetworkConditions& conditions);
+    void ClearConditions(uint8_t slot);
+    const NetworkConditions& GetConditions(uint8_t slot) const;
+    bool HasConditions(uint8_t slot) const;
+
+    void Send(uint8_t slot, const void* data, size_t size) override;
+    bool Receive(TransportMessage& message) override;
+
+    const NetworkSimulationStats& GetStats() const {
+        return m_Stats;
+    }
+
+  private:
+    struct Pending {
+        double due = 0.0;
+        uint8_t slot = 0;
+        std::vector<uint8_t> data;
+    };
+
+    void hold(uint8_t slot, const void* data, size_t size, double delay);
+    double delayFor(const NetworkConditions& conditions);
+    bool roll(float percent);
+    void deliverDue();
+
+    Transport& m_Inner;
+    std::mt19937 m_Random;
+
+    NetworkConditions m_Conditions;
+    NetworkConditions m_SlotConditions[MAX_SESSION_PLAYERS];
+    bool m_HasSlotConditions[MAX_SESSION_PLAYERS] = {};
+
+    std::vector<Pending> m_Pending;
+    double m_NextDue = 0.0; // Earliest due time in m_Pending
+
+    // Buffers of delivered messages, reused for the next ones held back
+    std::vector<std::vector<uint8_t>> m_FreeBuffers;
+
+    NetworkSimulationStats m_Stats;
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "game/network/BitStream.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// Players are named on the wire by a small per-session slot instead of
+// their 64-bit ID. The lobby owner hands slots out.
+const int PLAYER_SLOT_BITS = 7;
+const int MAX_SESSION_PLAYERS = 1 << PLAYER_SLOT_BITS;
+const uint8_t NO_PLAYER_SLOT = 0xFF;
+
+// Snapshots both sides remember, so a delta can point back at one the
+// receiver acknowledged. The age of that baseline must fit SNAPSHOT_AGE_BITS.
+const int SNAPSHOT_AGE_BITS = 5;
+const int SNAPSHOT_HISTORY = 1 << SNAPSHOT_AGE_BITS;
+
+// Steps per block for quantised positions
+const float POSITION_SCALE = 64.0f;
+
+// Angles as they go on the wire, shared by player states and input
+// commands: a full turn of yaw in 65536 steps, -90..90 of pitch in 255
+uint16_t QuantizeYaw(float yaw);
+float DequantizeYaw(uint16_t yaw); // 0..360
+uint8_t QuantizePitch(float pitch);
+float DequantizePitch(uint8_t pitch);
+
+// One player's state as it is sent: fixed-point position, 16-bit yaw and
+// 8-bit pitch
+struct PlayerState {
+    int32_t x = 0;
+    int32_t y = 0;
+    int32_t z = 0;
+    uint16_t yaw = 0;  // A full turn in 65536 steps
+    uint8_t pitch = 0; // -90..90 degrees in 255 steps
+
+    static PlayerState Quantize(glm::vec3 position, float yaw, float pitch);
+
+    glm::vec3 GetPosition() const;
+    float GetYaw() const; // 0..360
+    float GetPitch() const;
+
+    bool operator==(const PlayerState& other) const = default;
+};
+
+struct SnapshotEntry {
+    uint8_t slot = 0;
+    PlayerState state;
+};
+
+// Every player state one peer sent in one tick, sorted by slot
+struct Snapshot {
+    uint16_t sequence = 0;
+    uint32_t time = 0; // Sender's clock in ms, for interpolation
+    bool valid = false;
+    std::vector<SnapshotEntry> entries;
+};
+
+// True if sequence a comes after b, allowing for wrap-around
+inline bool IsSequenceNewer(uint16_t a, uint16_t b) {
+    return (int16_t)(a - b) > 0;
+}
+
+// Sending side. Each tick starts a new snapshot; Write() then encodes it
+// for one receiver as a delta against the newest snapshot that receiver
+// acknowledged, or in full if there is none.
+class SnapshotEncoder {
+  public:
+    SnapshotEncoder();
+
+    void Begin(uint32_t timeMs);
+
+    // Entries must be added in increasing slot order
+    void Add(uint8_t slot, const PlayerState& state);
+
+    // Writes a whole PacketType::PlayerState packet into out
+    void Write(uint8_t senderSlot,
+               uint8_t targetSlot,
+               std::vector<uint8_t>& out);
+
+    void Acknowledge(uint8_t targetSlot, uint16_t sequence);
+
+    // Forgets what a receiver acknowledged, e.g. its slot was reused
+    void Forget(uint8_t targetSlot);
+
+    uint16_t GetSequence() const {
+        return m_Sequence;
+    }
+
+  private:
+    Snapshot m_History[SNAPSHOT_HISTORY];
+    uint16_t m_Sequence = 0;
+    int32_t m_Acked[MAX_SESSION_PLAYERS]; // -1 until the first ack
+};
+
+// Receiving side, one per sender. Keeps what it decoded so later deltas
+// can be applied on top.
+class SnapshotDecoder {
+  public:
+    // Reads the rest of a PlayerState packet (after type and sender slot).
+    // nullptr if it is corrupt or its baseline is no longer known. newest
+    // is set if no later snapshot has been read yet.
+    const Snapshot* Read(BitReader& reader, bool& newest);
+
+    void Reset();
+
+  private:
+    Snapshot m_History[SNAPSHOT_HISTORY];
+    uint16_t m_Newest = 0;
+    bool m_HasNewest = false;
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "game/network/Snapshot.hpp"
+#include <cstddef>
+#include <cstdint>
+
+// One message as it came off the wire. The sender is whichever slot the
+// backend knows the other end by, never anything the message says about
+// itself; NO_PLAYER_SLOT if it knows of none.
+struct TransportMessage {
+    const void* data = nullptr;
+    size_t size = 0;
+    uint8_t sender = NO_PLAYER_SLOT;
+};
+
+// Moves session messages between peers, who are addressed by their session
+// slot. Delivery is unreliable and unordered, like the UDP it usually is;
+// the protocol above copes with both. NetworkSession sends and receives
+// through whichever backend it was given:
+//
+//   SteamTransport     Steam networking messages, peers from the lobby
+//   LoopbackTransport  in-process queues, for the headless server and
+//                      benchmarks
+//   UdpTransport       plain sockets, for LAN and dedicated servers
+//
+// Connecting is backend specific and happens outside this interface.
+class Transport {
+  public:
+    virtual ~Transport() = default;
+
+    // Sends one message to the peer in a slot. Unknown slots are dropped.
+    virtual void Send(uint8_t slot, const void* data, size_t size) = 0;
+
+    // The next message waiting. Its data stays valid until the next call.
+    // False once there is nothing left.
+    virtual bool Receive(TransportMessage& message) = 0;
+};
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "game/network/NetworkPackets.hpp"
+#include "game/network/SimulatedTransport.hpp"
+#include "platform/SteamTransport.hpp"
 #include <steam/steam_api.h>
 #include <glm/glm.hpp>
-#include <map>
 #include <string>
+#include <vector>
 
 struct LobbyInfo {
     CSteamID id;
@@ -28,14 +30,11 @@ class Steam {
     inline static std::vector<LobbyInfo> FoundLobbies;
 
     // === Networking ===
+    // Once per network tick; see NetworkSession::SendTick
     static void SendPosition(glm::vec3 pos, float yaw, float pitch);
+    // Hands every waiting message to NetworkSession
     static void ReceivePackets();
-    static void InterpolatePlayers(float deltaTime);
     static int GetPing(uint64_t targetID);
-    static int GetAndResetPacketCount();
-
-    // === Remote Player Data ===
-    inline static std::map<uint64_t, RemotePlayerData> RemotePlayers;
 
   private:
     // Singleton for callbacks
@@ -50,14 +49,19 @@ class Steam {
                           bool bIOFailure); // Non-static for CCallResult
     static void OnLobbyEntered(LobbyEnter_t* pCallback, bool bIOFailure);
     STEAM_CALLBACK(Steam, OnLobbyChatUpdate, LobbyChatUpdate_t);
+    STEAM_CALLBACK(Steam, OnLobbyDataUpdate, LobbyDataUpdate_t);
     CCallResult<Steam, LobbyMatchList_t> m_LobbyMatchListCallResult;
 
+    // Session slots live in lobby data ("slot<n>" = Steam ID). Only the
+    // owner writes them; everyone mirrors them into NetworkSession.
+    static void assignSlots();
+    static void readSlots();
+
     // State
     inline static SteamAPICall_t m_LobbyCreateCall = k_uAPICallInvalid;
     inline static SteamAPICall_t m_LobbyMatchListCall = k_uAPICallInvalid;
     inline static SteamAPICall_t m_LobbyEnterCall = k_uAPICallInvalid;
     inline static CSteamID m_CurrentLobbyID;
-
-    // Static packet counter for tickrate calculation
-    inline static int s_PacketsReceivedThisSecond = 0;
+    inline static SteamTransport m_Transport;
+    inline static SimulatedTransport m_Simulator{m_Transport};
 };
\ No newline at end of file
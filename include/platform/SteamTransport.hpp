@@ -0,0 +1,23 @@
+#pragma once
+
+#include "game/network/Transport.hpp"
+#include <steam/steam_api.h>
+
+// Session messages over SteamNetworkingMessages. Peers are whoever the
+// lobby's slot table says; see Steam::readSlots. Messages are pulled a
+// batch at a time and released once the batch has been handed out.
+class SteamTransport : public Transport {
+  public:
+    ~SteamTransport() override;
+
+    void Send(uint8_t slot, const void* data, size_t size) override;
+    bool Receive(TransportMessage& message) override;
+
+  private:
+    void release();
+
+    static const int RECEIVE_BATCH_SIZE = 64;
+    SteamNetworkingMessage_t* m_Batch[RECEIVE_BATCH_SIZE] = {};
+    int m_Count = 0;
+    int m_Next = 0;
+};
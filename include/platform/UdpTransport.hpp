@@ -0,0 +1,100 @@
+#pragma once
+
+#include "game/network/Snapshot.hpp"
+#include "game/network/Transport.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// A client joining or leaving, or (on a client) the host accepting or
+// dropping us
+struct UdpConnectionEvent {
+    bool connected = false;
+    uint8_t slot = NO_PLAYER_SLOT;
+    uint64_t playerID = 0;
+};
+
+// Session messages over a plain non-blocking IPv4 UDP socket, for LAN
+// games and dedicated servers where there is no Steam.
+//
+// The host listens on a port and gives every client that says hello the
+// first free slot. A client repeats its hello until the host answers with
+// its slot. Either side forgets the other after a few seconds of silence;
+// the session's own traffic doubles as the keepalive. Joins and leaves
+// come out of PollEvent(), and the owner updates the slot table from them.
+class UdpTransport : public Transport {
+  public:
+    UdpTransport();
+    ~UdpTransport() override;
+
+    UdpTransport(const UdpTransport&) = delete;
+    UdpTransport& operator=(const UdpTransport&) = delete;
+
+    // Host side. hostSlot is ours and never handed out.
+    bool Listen(uint16_t port, uint8_t hostSlot);
+
+    // Client side. Returns once the socket is up; IsConnected() turns true
+    // when the host answers.
+    bool Connect(const std::string& host, uint16_t port, uint64_t playerID);
+
+    // Says goodbye to the other end(s) and closes the socket
+    void Close();
+
+    void Send(uint8_t slot, const void* data, size_t size) override;
+    bool Receive(TransportMessage& message) override;
+
+    // Joins and leaves since the last call, oldest first
+    bool PollEvent(UdpConnectionEvent& event);
+
+    bool IsHost() const {
+        return m_IsHost;
+    }
+    bool IsConnected() const {
+        return m_LocalSlot != NO_PLAYER_SLOT;
+    }
+    uint8_t GetLocalSlot() const {
+        return m_LocalSlot;
+    }
+    uint8_t GetHostSlot() const {
+        return m_HostSlot;
+    }
+
+  private:
+    struct Peer {
+        bool active = false;
+        uint32_t address = 0; // Host byte order
+        uint16_t port = 0;
+        uint64_t playerID = 0;
+        double lastHeard = 0.0;
+    };
+
+    bool open(uint16_t port);
+    void sendTo(const Peer& peer, uint8_t kind, const void* data, size_t size);
+
+    // Hello, welcome and goodbye
+    void handleControl(const Peer& from, const uint8_t* data, size_t size);
+    void accept(const Peer& from, uint64_t playerID);
+    void drop(uint8_t slot);
+    void disconnect();
+
+    // Hellos, timeouts; run whenever Receive runs dry
+    void update();
+
+    intptr_t m_Socket = -1; // SOCKET on Windows, fd elsewhere
+    bool m_IsHost = false;
+    uint8_t m_LocalSlot = NO_PLAYER_SLOT;
+    uint8_t m_HostSlot = NO_PLAYER_SLOT;
+    uint64_t m_PlayerID = 0;
+    double m_LastHello = 0.0;
+
+    // The host's clients by slot, or a client's host
+    Peer m_Peers[MAX_SESSION_PLAYERS];
+    std::unordered_map<uint64_t, uint8_t> m_SlotByAddress;
+    Peer m_Server;
+
+    std::vector<UdpConnectionEvent> m_Events;
+    size_t m_EventCursor = 0;
+    std::vector<uint8_t> m_SendBuffer;
+    std::vector<uint8_t> m_ReceiveBuffer;
+};
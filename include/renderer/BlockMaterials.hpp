@@ -0,0 +1,47 @@
+#pragma once
+
+#include "game/Block.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+
+// Layers of the block texture array (one per block face texture)
+enum class BlockTexture : uint32_t {
+    GrassTop = 0,
+    GrassSide,
+    Dirt,
+    Stone,
+    Lamp,
+};
+
+const int BLOCK_TEXTURE_COUNT = 5;
+const int BLOCK_TEXTURE_SIZE = 16;
+
+// Per-BlockType material, laid out to match the std430 struct in basic.frag.
+// Faces use the mesher order: back, front, left, right, bottom, top.
+struct BlockMaterial {
+    glm::vec4 tint;
+    uint32_t faceLayers[6];
+    uint32_t padding[2];
+};
+
+class BlockMaterials {
+  public:
+    BlockMaterials();
+    ~BlockMaterials();
+
+    void Init();
+
+    // Deletes the texture array and SSBO; needs the GL context current
+    void Release();
+
+    // Binds the texture array to unit 0 and the material SSBO to binding 0.
+    // Called once per frame no matter how many block types exist.
+    void Bind() const;
+
+  private:
+    void createTextureArray();
+    void createMaterialBuffer();
+
+    unsigned int m_TextureArray = 0;
+    unsigned int m_MaterialSSBO = 0;
+};
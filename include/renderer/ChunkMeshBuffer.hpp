@@ -0,0 +1,27 @@
+#pragma once
+#include "game/ChunkVertex.hpp"
+#include <cstddef>
+
+// VAO/VBO pair holding one chunk-format mesh (chunks and LOD tiles)
+class ChunkMeshBuffer {
+  public:
+    ChunkMeshBuffer() = default;
+    ~ChunkMeshBuffer();
+
+    ChunkMeshBuffer(const ChunkMeshBuffer&) = delete;
+    ChunkMeshBuffer& operator=(const ChunkMeshBuffer&) = delete;
+
+    void Upload(const ChunkVertex* vertices, size_t count);
+    void Draw() const;
+    void Release();
+
+    int GetVertexCount() const {
+        return m_VertexCount;
+    }
+
+  private:
+    unsigned int m_VAO = 0;
+    unsigned int m_VBO = 0;
+    int m_VertexCount = 0;
+    size_t m_Bytes = 0; // Counted under MemoryCategory::GpuBuffers
+};
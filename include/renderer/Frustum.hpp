@@ -0,0 +1,15 @@
+#pragma once
+#include <glm/glm.hpp>
+
+// View frustum as 6 planes pulled out of a view-projection matrix
+class Frustum {
+  public:
+    explicit Frustum(const glm::mat4& viewProjection);
+
+    // Conservative test: false only if the box is fully outside a plane
+    bool IsBoxVisible(glm::vec3 min, glm::vec3 max) const;
+
+  private:
+    // xyz = normal pointing inwards, w = distance
+    glm::vec4 m_Planes[6];
+};
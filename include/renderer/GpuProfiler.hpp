@@ -0,0 +1,99 @@
+#pragma once
+
+#include "core/Profiler.hpp"
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+struct GpuZoneResult {
+    const char* name;
+    double ms;
+};
+
+// GPU pass timings from GL_TIMESTAMP queries. Queries for a frame are read
+// back FRAME_LATENCY frames later, and only if the GPU is already done
+// with them, so the CPU never waits on the GPU.
+class GpuProfiler {
+  public:
+    // Call once per frame before any zone, with the GL context current
+    static void BeginFrame();
+    static void Shutdown();
+
+    // Returns a zone handle for EndZone, or -1 if the frame is full
+    static int BeginZone(const char* name);
+    static void EndZone(int zone);
+
+    // Most recent frame whose queries have come back
+    static const std::vector<GpuZoneResult>& GetLastResults() {
+        return m_LastResults;
+    }
+    // Smoothed per-zone time, for a steadier readout
+    static const std::map<std::string, double>& GetAverages() {
+        return m_Averages;
+    }
+    // Frames skipped because their queries weren't ready in time
+    static uint64_t GetDroppedFrames() {
+        return m_DroppedFrames;
+    }
+
+    // Writes the recorded history as CSV: frame,zone,ms
+    static bool ExportCsv(const std::string& path);
+
+  private:
+    static const int FRAME_LATENCY = 4;
+    static const int MAX_ZONES = 32;
+    static const size_t HISTORY_FRAMES = 600;
+
+    struct FrameQueries {
+        unsigned int queries[MAX_ZONES * 2] = {};
+        const char* names[MAX_ZONES] = {};
+        int zoneCount = 0;
+        int lastQuery = -1; // Latest query issued; done means all are
+        uint64_t frameNumber = 0;
+        uint64_t cpuStart = 0; // CPU time of the first zone, for traces
+    };
+
+    struct HistoryFrame {
+        uint64_t frameNumber;
+        std::vector<GpuZoneResult> zones;
+    };
+
+    static void resolve(FrameQueries& frame);
+
+    inline static bool m_Initialized = false;
+    static FrameQueries m_Frames[FRAME_LATENCY]; // Defined in the .cpp
+    inline static int m_FrameIndex = 0;
+    inline static uint64_t m_FrameNumber = 0;
+    inline static uint64_t m_DroppedFrames = 0;
+
+    inline static std::vector<GpuZoneResult> m_LastResults;
+    inline static std::map<std::string, double> m_Averages;
+    inline static std::deque<HistoryFrame> m_History;
+};
+
+// Times the GPU work issued inside the enclosing scope
+class GpuZone {
+  public:
+    explicit GpuZone(const char* name) {
+        if (Profiler::IsEnabled())
+            m_Zone = GpuProfiler::BeginZone(name);
+    }
+    ~GpuZone() {
+        GpuProfiler::EndZone(m_Zone);
+    }
+
+    GpuZone(const GpuZone&) = delete;
+    GpuZone& operator=(const GpuZone&) = delete;
+
+  private:
+    int m_Zone = -1;
+};
+
+#ifdef ORIX_PROFILING
+#define ORIX_GPU_ZONE(name)                                                    \
+    GpuZone ORIX_PROFILE_CONCAT(gpuZone_, __LINE__)(name)
+#else
+#define ORIX_GPU_ZONE(name)
+#endif
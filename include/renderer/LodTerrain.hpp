@@ -0,0 +1,99 @@
+#pragma once
+#include "game/Chunk.hpp"
+#include "game/MeshQueue.hpp"
+#include "game/TerrainGenerator.hpp"
+#include "renderer/ChunkMeshBuffer.hpp"
+#include "renderer/Frustum.hpp"
+#include "renderer/Shader.hpp"
+#include <glm/glm.hpp>
+#include <map>
+#include <memory>
+#include <vector>
+
+class World;
+
+// Levels 1..LOD_LEVEL_COUNT are meshed from terrain downsampled by 2^level.
+// A tile is always CHUNK_SIZE cells wide, so it covers CHUNK_SIZE * 2^level
+// blocks.
+const int LOD_LEVEL_COUNT = 3;
+
+// Far terrain is drawn out to this distance (in blocks) from the camera
+const float LOD_HORIZON = 1024.0f;
+
+// Far-terrain tiles arranged as a quadtree per 8x tile. Nodes split while
+// the camera is close enough and their children have meshes, so there are
+// never holes while finer tiles are still being built.
+class LodTerrain {
+  public:
+    explicit LodTerrain(const TerrainGenerator& terrain);
+    ~LodTerrain();
+
+    LodTerrain(const LodTerrain&) = delete;
+    LodTerrain& operator=(const LodTerrain&) = delete;
+
+    // Uploads tile meshes the workers have finished since last frame
+    void Update();
+
+    // Picks the tiles to draw this frame and queues meshes for missing ones
+    void Select(World& world, glm::vec3 cameraPos, const Frustum& frustum);
+    void Render(Shader& shader);
+
+    // Waits for tile jobs in flight and deletes every tile's buffers
+    void Release();
+
+    int GetTilesDrawn() const {
+        return (int)m_Selected.size();
+    }
+    int GetTrianglesDrawn() const {
+        return m_TrianglesDrawn;
+    }
+
+  private:
+    struct LodTile {
+        ChunkMeshBuffer mesh;
+        bool meshed = false;
+        bool pending = false;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    struct SelectedTile {
+        glm::ivec3 origin;
+        int level;
+        const LodTile* tile;
+    };
+
+    // Keyed by (origin.x, level, origin.z); all tiles sit at y = 0
+    static glm::ivec3 tileKey(glm::ivec3 origin, int level);
+    static int tileSize(int level);
+
+    LodTile& getTile(glm::ivec3 origin, int level);
+    bool isReady(glm::ivec3 origin, int level);
+    bool hasLoadedChunks(World& world, glm::ivec3 origin);
+    void selectNode(World& world,
+                    glm::ivec3 origin,
+                    int level,
+                    glm::vec3 cameraPos,
+                    const Frustum& frustum);
+    void requestMesh(glm::ivec3 origin, int level, LodTile& tile);
+    void gatherTile(glm::ivec3 origin, int level, ChunkNeighbourhood& out);
+    void applyMesh(ChunkMeshData& data);
+    void evictUnused();
+
+    const TerrainGenerator& m_Terrain;
+
+    // Tiles are meshed on the job system like chunks, but land here
+    MeshQueue m_MeshQueue;
+    std::vector<MeshJob*> m_FinishedMeshes;
+
+    std::map<glm::ivec3, std::unique_ptr<LodTile>, IVec3Compare> m_Tiles;
+    std::vector<SelectedTile> m_Selected;
+
+    uint64_t m_Frame = 0;
+    int m_RequestsThisFrame = 0;
+    int m_JobsInFlight = 0; // Tiles with pending set
+
+    // Set by the GPU budget hook: drop every tile not drawn last frame
+    int m_EvictionHook = 0;
+    bool m_OverBudget = false;
+    int m_TrianglesDrawn = 0;
+};
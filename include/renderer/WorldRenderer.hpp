@@ -0,0 +1,71 @@
+#pragma once
+
+#include "core/Camera.hpp"
+#include "game/Chunk.hpp"
+#include "game/ChunkPool.hpp"
+#include "renderer/BlockMaterials.hpp"
+#include "renderer/ChunkMeshBuffer.hpp"
+#include "renderer/LodTerrain.hpp"
+#include "renderer/Shader.hpp"
+#include <glm/glm.hpp>
+#include <map>
+#include <memory>
+#include <vector>
+
+class World;
+
+// What the last WorldRenderer::Render call drew, for the debug overlay
+struct WorldRenderStats {
+    int chunksDrawn = 0;
+    int lodTilesDrawn = 0;
+    int drawCalls = 0;
+    int triangles = 0;
+};
+
+// GL side of the world: chunk buffers, far LOD terrain, block materials
+// and the remote player cubes. Chunk meshes are re-uploaded whenever their
+// CPU mesh version moves on.
+class WorldRenderer {
+  public:
+    explicit WorldRenderer(World& world);
+
+    void Init();
+
+    // Deletes every GL object the renderer owns. Call it while the context
+    // is still current; destruction comes too late for that.
+    void Shutdown();
+
+    void Render(Shader& shader, const Camera& camera, int width, int height);
+
+    const WorldRenderStats& GetRenderStats() const {
+        return m_RenderStats;
+    }
+
+  private:
+    struct ChunkGpuMesh {
+        ChunkMeshBuffer buffer;
+        ChunkHandle chunk; // Stale once the chunk is unloaded
+        uint32_t version = 0;
+    };
+
+    void releaseUnloadedMeshes();
+    void uploadChangedMeshes();
+
+    World& m_World;
+    std::map<glm::ivec3, std::unique_ptr<ChunkGpuMesh>, IVec3Compare>
+        m_ChunkMeshes;
+
+    // Block texture array + material table shared by every chunk
+    BlockMaterials m_Materials;
+
+    // Downsampled terrain out to the horizon, beyond the loaded chunks
+    LodTerrain m_Lod;
+    WorldRenderStats m_RenderStats;
+
+    // Player cube mesh for rendering remote players, drawn flat coloured
+    // with their own shader
+    unsigned int m_PlayerCubeVAO = 0;
+    unsigned int m_PlayerCubeVBO = 0;
+    std::unique_ptr<Shader> m_PlayerShader;
+    void InitPlayerCube();
+};
@@ -1,10 +1,20 @@
 #pragma once
+#include "game/Block.hpp"
+#include "game/PlayerInput.hpp"
 #include "states/State.hpp"
 
 class PlayState : public State {
   public:
     void OnEnter(Application* app) override;
     void OnExit(Application* app) override;
+    void FixedUpdate(float step, Application* app) override;
     void Update(float deltaTime, Application* app) override;
     void Render(Application* app) override;
+
+  private:
+    void HandleBlockInteraction(Application* app);
+    PlayerInput readPlayerInput() const;
+
+    BlockType m_SelectedBlock = BlockType::Stone;
+    float m_NetworkTimer = 0.0f;
 };
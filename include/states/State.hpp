@@ -8,6 +8,9 @@ class State {
 
     virtual void OnEnter(Application* app) {}
     virtual void OnExit(Application* app) {}
+    // Called zero or more times per frame with a constant step
+    virtual void FixedUpdate(float step, Application* app) {}
+    // Called once per frame with the real frame time
     virtual void Update(float deltaTime, Application* app) {}
     virtual void Render(Application* app) {}
 };
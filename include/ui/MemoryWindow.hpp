@@ -0,0 +1,7 @@
+#pragma once
+
+// ImGui table of MemoryTracker: current, peak and budget per category
+class MemoryWindow {
+  public:
+    void Draw(bool* open);
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+// ImGui view of NetworkStats: traffic per second and what each player
+// costs, next to what the same states would cost uncompressed. Also the
+// remote player interpolation buffers, with the delay adjustable live, and
+// how often the host corrected our predicted movement, and the simulated
+// network conditions when the session runs through a SimulatedTransport.
+class NetworkWindow {
+  public:
+    void Draw(bool* open);
+
+  private:
+    void drawConditions();
+
+    int m_ConditionSlot = -1; // Whose conditions are edited; -1 for all
+};
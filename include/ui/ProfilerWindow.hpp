@@ -0,0 +1,17 @@
+#pragma once
+
+// ImGui view of the profilers: a per-thread CPU timeline of the last frame
+// (nested zones stack downwards like a flame graph), a table of min/avg/max
+// per CPU zone and the GPU pass timings
+class ProfilerWindow {
+  public:
+    void Draw(bool* open);
+
+  private:
+    void drawTimeline();
+    void drawZoneTable();
+    void drawGpuTable();
+
+    // Visible span of the timeline in milliseconds
+    float m_TimelineRangeMs = 20.0f;
+};
@@ -1,7 +1,24 @@
 #version 450 core
 out vec4 FragColor;
 in vec2 TexCoord;
-in float vBlockID;
+in float vAO;
+in vec3 vLight;
+flat in uint vBlockID;
+flat in uint vFace;
+
+// One layer per block face texture, see BlockMaterials.cpp
+layout (binding = 0) uniform sampler2DArray u_BlockTextures;
+
+// Per-BlockType material, mirrors struct BlockMaterial on the CPU side
+struct BlockMaterial {
+    vec4 tint;
+    uint faceLayers[6];
+    uint padding[2];
+};
+
+layout (std430, binding = 0) readonly buffer BlockMaterialBuffer {
+    BlockMaterial materials[];
+};
 
 void main() {
     float borderSize = 0.01;
@@ -13,15 +30,12 @@ void main() {
     // 1.0 if we are in the border, 0.0 if we are in the block center
     float isBorder = 1.0 - step(borderSize, edgeDist);
 
-    // BlockType: Air=0, Grass=1, Dirt=2, Stone=3
-    vec3 blockColor;
-    if (vBlockID < 1.5) {
-        blockColor = vec3(0.1, 0.8, 0.2); // Grass - bright green
-    } else if (vBlockID < 2.5) {
-        blockColor = vec3(0.6, 0.4, 0.2); // Dirt - brown
-    } else {
-        blockColor = vec3(0.5, 0.5, 0.5); // Stone - gray
-    }
+    // Material lookup is a plain index, no per-type branches
+    BlockMaterial material = materials[vBlockID];
+    float layer = float(material.faceLayers[vFace]);
+    vec3 blockColor =
+        texture(u_BlockTextures, vec3(TexCoord, layer)).rgb * material.tint.rgb;
+    blockColor *= vAO * vLight;
 
     // Blend between block color and black border
     vec3 finalColor = mix(blockColor, vec3(0.0, 0.0, 0.0), isBorder);
@@ -1,16 +1,36 @@
 #version 450 core
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec2 aTexCoord;
-layout (location = 2) in float aBlockID;
+// bits 0-7: BlockType, 8-10: face, 11-12: AO, 13-16: sky, 17-20: block light
+layout (location = 2) in uint aData;
 
 out vec2 TexCoord;
-out float vBlockID;
+out float vAO;
+out vec3 vLight;
+flat out uint vBlockID;
+flat out uint vFace;
 
 uniform mat4 u_VP;    // View * Projection
 uniform mat4 u_Model; // Per-chunk position
 
+// Brightness for each baked AO level (0 = enclosed corner, 3 = open)
+const float AO_CURVE[4] = float[](0.45, 0.65, 0.82, 1.0);
+
+// Each light level is 80% as bright as the one above it
+float lightCurve(uint level) {
+    return pow(0.8, float(15u - level));
+}
+
 void main() {
     gl_Position = u_VP * u_Model * vec4(aPos, 1.0);
     TexCoord = aTexCoord;
-    vBlockID = aBlockID;
+    vBlockID = aData & 0xFFu;
+    vFace = (aData >> 8) & 0x7u;
+    vAO = AO_CURVE[(aData >> 11) & 0x3u];
+
+    // Sky light is neutral, block light is a warm torch colour
+    float sky = lightCurve((aData >> 13) & 0xFu);
+    float block = lightCurve((aData >> 17) & 0xFu);
+    vLight = max(vec3(sky), vec3(1.0, 0.85, 0.6) * block);
+    vLight = max(vLight, vec3(0.03)); // Never fully black
 }
\ No newline at end of file
@@ -0,0 +1,10 @@
+#version 450 core
+out vec4 FragColor;
+
+// Remote player cubes are a flat colour; they have no block data for
+// basic.frag's materials and lighting
+uniform vec3 u_Color;
+
+void main() {
+    FragColor = vec4(u_Color, 1.0);
+}
@@ -0,0 +1,9 @@
+#version 450 core
+layout (location = 0) in vec3 aPos;
+
+uniform mat4 u_VP;    // View * Projection
+uniform mat4 u_Model; // Body or head placement
+
+void main() {
+    gl_Position = u_VP * u_Model * vec4(aPos, 1.0);
+}
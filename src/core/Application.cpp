@@ -1,9 +1,21 @@
 #include "core/Application.hpp"
+#include "core/CommandLine.hpp"
+#include "core/FrameArena.hpp"
 #include "core/Input.hpp"
+#include "core/InputRecorder.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/JobSystem.hpp"
+#include "core/Profiler.hpp"
+#include "core/TraceCapture.hpp"
+#include "game/network/NetworkSession.hpp"
+#include "game/network/NetworkStats.hpp"
 #include "platform/Steam.hpp"
+#include "renderer/GpuProfiler.hpp"
 #include "states/MainMenuState.hpp"
 #include "states/PlayState.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 #ifdef _WIN32
@@ -11,15 +23,28 @@
 #undef GetUserName
 #endif
 
+namespace {
+// Frames recorded by the F4 trace capture (about 5 seconds at 60 fps)
+const int TRACE_CAPTURE_FRAMES = 300;
+} // namespace
+
 Application::Application()
     : m_Window(nullptr), m_GLContext(nullptr), m_Running(true),
-      m_IsMouseLocked(false), m_LastFrame(0.0f) {}
+      m_IsMouseLocked(false), m_WorldRenderer(m_World) {}
 
 Application::~Application() {
     Cleanup();
 }
 
 bool Application::Initialize() {
+    int simulationRate = CommandLine::GetInt("--sim-rate", 60);
+    if (simulationRate <= 0 || simulationRate > MAX_SIMULATION_RATE) {
+        std::cerr << "[Application] --sim-rate must be between 1 and "
+                  << MAX_SIMULATION_RATE << std::endl;
+        return false;
+    }
+    SetSimulationRate((float)simulationRate);
+
     if (!Steam::Init())
         return false;
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) != 0)
@@ -50,6 +75,10 @@ bool Application::Initialize() {
     m_StateManager = std::make_unique<StateManager>(this);
     m_StateManager->PushState(std::make_unique<MainMenuState>());
 
+    // A replay is a benchmark run, so skip the menu
+    if (CommandLine::HasFlag("--replay"))
+        EnterGame();
+
     glEnable(GL_DEPTH_TEST);
     Input::SetCursorLock(m_IsMouseLocked);
 
@@ -57,8 +86,19 @@ bool Application::Initialize() {
     m_BasicShader =
         std::make_unique<Shader>("shaders/basic.vert", "shaders/basic.frag");
 
+    // Workers are shared by meshing, generation and lighting
+    Profiler::SetThreadName("Main");
+    JobSystem::Init();
+
     // Initialize World
     m_World.Init();
+    m_WorldRenderer.Init();
+
+    // --trace <frames> [--trace-file <path>] records from the first frame
+    int traceFrames = CommandLine::GetInt("--trace", 0);
+    if (traceFrames > 0)
+        TraceCapture::Begin(traceFrames,
+                            CommandLine::GetString("--trace-file"));
 
     return true;
 }
@@ -67,23 +107,62 @@ int Application::Run() {
     if (!Initialize())
         return -1;
 
+    const double frequency = (double)SDL_GetPerformanceFrequency();
+    m_LastCounter = SDL_GetPerformanceCounter();
+
     while (m_Running) {
-        float currentFrame = SDL_GetTicks() / 1000.0f;
-        float deltaTime = currentFrame - m_LastFrame;
-        m_LastFrame = currentFrame;
+        Profiler::BeginFrame();
+
+        Uint64 counter = SDL_GetPerformanceCounter();
+        double frameTime = (counter - m_LastCounter) / frequency;
+        m_LastCounter = counter;
+
+        ProcessEvents((float)frameTime);
+
+        // A replay substitutes the recorded frame time, so the fixed steps
+        // below land exactly where they did while recording
+        if (m_Replaying) {
+            if (!InputRecorder::IsReplaying()) {
+                finishReplay();
+                break;
+            }
+            m_ReplayFrameTimes.push_back(frameTime * 1000.0);
+        }
+        frameTime = Input::GetFrameTime();
 
-        ProcessEvents();
-        Update(deltaTime);
+        // Simulation advances in fixed steps no matter the frame rate
+        const double step = 1.0 / m_SimulationRate;
+        m_Accumulator += frameTime;
+
+        int steps = 0;
+        while (m_Accumulator >= step && steps < m_MaxSimulationSteps) {
+            FixedUpdate((float)step);
+            m_Accumulator -= step;
+            steps++;
+        }
+        if (m_Accumulator >= step)
+            m_Accumulator = 0.0;
+
+        m_InterpolationAlpha = (float)(m_Accumulator / step);
+
+        Update((float)frameTime);
         Steam::Update();
         Render();
+
+        ORIX_PROFILE_COUNTER("Frame Arena KB",
+                             (int64_t)FrameArena::Get().GetUsed() / 1024);
+        FrameArena::Get().Reset();
+        Profiler::EndFrame();
     }
 
     return 0;
 }
 
-void Application::ProcessEvents() {
+void Application::ProcessEvents(float frameTime) {
+    ORIX_PROFILE_ZONE("Application::ProcessEvents");
+
     // Update input BEFORE processing events to capture previous frame state
-    Input::Update();
+    Input::Update(frameTime);
 
     SDL_Event e;
     while (SDL_PollEvent(&e)) {
@@ -92,6 +171,17 @@ void Application::ProcessEvents() {
             m_Running = false;
     }
 
+    if (Input::IsKeyPressed(SDL_SCANCODE_F3))
+        m_ShowProfiler = !m_ShowProfiler;
+    if (Input::IsKeyPressed(SDL_SCANCODE_F5))
+        m_ShowMemory = !m_ShowMemory;
+    if (Input::IsKeyPressed(SDL_SCANCODE_F6))
+        m_ShowNetwork = !m_ShowNetwork;
+
+    // F4 records a trace of the next few seconds for bug reports
+    if (Input::IsKeyPressed(SDL_SCANCODE_F4))
+        TraceCapture::Begin(TRACE_CAPTURE_FRAMES);
+
     if (Input::IsKeyPressed(SDL_SCANCODE_ESCAPE)) {
         // Toggle mouse lock or return to menu logic could go here
         // For now, let's keep it simple or delegate to state
@@ -100,16 +190,31 @@ void Application::ProcessEvents() {
     }
 }
 
+void Application::FixedUpdate(float step) {
+    ORIX_PROFILE_ZONE("Application::FixedUpdate");
+    m_StateManager->FixedUpdate(step);
+}
+
 void Application::Update(float deltaTime) {
+    ORIX_PROFILE_ZONE("Application::Update");
+
     if (m_PendingState) {
         m_StateManager->ChangeState(std::move(m_PendingState));
+        beginInputCapture();
     }
 
     m_UIManager->Update();
     m_StateManager->Update(deltaTime);
+
+    // Over-budget categories get their eviction hooks run
+    MemoryTracker::Update();
+    NetworkStats::Update();
 }
 
 void Application::Render() {
+    ORIX_PROFILE_ZONE("Application::Render");
+    GpuProfiler::BeginFrame();
+
     glClearColor(0.5f, 0.8f, 1.0f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -119,6 +224,13 @@ void Application::Render() {
     // Render world/game content
     m_StateManager->Render();
 
+    if (m_ShowProfiler)
+        m_ProfilerWindow.Draw(&m_ShowProfiler);
+    if (m_ShowMemory)
+        m_MemoryWindow.Draw(&m_ShowMemory);
+    if (m_ShowNetwork)
+        m_NetworkWindow.Draw(&m_ShowNetwork);
+
     // Render RmlUi and finish ImGui
     m_UIManager->Render();
     m_UIManager->EndFrame();
@@ -130,6 +242,82 @@ void Application::EnterGame() {
     m_PendingState = std::make_unique<PlayState>();
 }
 
+void Application::SetSimulationRate(float rate) {
+    m_SimulationRate = rate;
+    NetworkSession::SetSimulationRate((int)std::lround(rate));
+}
+
+void Application::beginInputCapture() {
+    std::string replayPath = CommandLine::GetString("--replay");
+    std::string recordPath = CommandLine::GetString("--record");
+
+    if (!replayPath.empty()) {
+        InputRecordingStart start;
+        if (!InputRecorder::BeginReplay(replayPath, start)) {
+            m_Running = false;
+            return;
+        }
+        if (start.seed != m_World.GetSeed())
+            std::cerr << "[Replay] Recorded with seed " << start.seed
+                      << ", world uses " << m_World.GetSeed()
+                      << "; the run will diverge" << std::endl;
+
+        SetSimulationRate(start.simulationRate);
+        m_Player.Position = start.position;
+        m_Player.PreviousPosition = start.position;
+        m_Player.Velocity = start.velocity;
+        m_Player.IsGrounded = start.grounded;
+        m_Player.SetRotation(start.yaw, start.pitch);
+
+        m_Replaying = true;
+        m_ReplayFrameTimes.clear();
+    } else if (!recordPath.empty()) {
+        InputRecordingStart start;
+        start.seed = m_World.GetSeed();
+        start.simulationRate = m_SimulationRate;
+        start.position = m_Player.Position;
+        start.velocity = m_Player.Velocity;
+        start.yaw = m_Player.Yaw;
+        start.pitch = m_Player.Pitch;
+        start.grounded = m_Player.IsGrounded;
+        if (!InputRecorder::BeginRecording(recordPath, start))
+            return;
+    } else {
+        return;
+    }
+
+    // Both runs start stepping from an empty accumulator
+    m_Accumulator = 0.0;
+}
+
+void Application::finishReplay() {
+    m_Replaying = false;
+    m_Running = false;
+
+    std::vector<double>& times = m_ReplayFrameTimes;
+    if (times.empty())
+        return;
+
+    // The first frame includes the state change and the initial uploads
+    if (times.size() > 1)
+        times.erase(times.begin());
+    std::sort(times.begin(), times.end());
+
+    double total = 0.0;
+    for (double t : times)
+        total += t;
+
+    auto percentile = [&](double p) {
+        return times[(size_t)(p * (times.size() - 1))];
+    };
+
+    std::cout << "[Replay] " << times.size() << " frames, avg "
+              << total / times.size() << " ms, p50 " << percentile(0.5)
+              << " ms, p95 " << percentile(0.95) << " ms, p99 "
+              << percentile(0.99) << " ms, max " << times.back() << " ms"
+              << std::endl;
+}
+
 void Application::SetMouseLocked(bool locked) {
     m_IsMouseLocked = locked;
     Input::SetCursorLock(locked);
@@ -137,8 +325,18 @@ void Application::SetMouseLocked(bool locked) {
 }
 
 void Application::Cleanup() {
+    InputRecorder::EndRecording();
+    InputRecorder::EndReplay();
     m_StateManager = nullptr;
     m_UIManager = nullptr;
+
+    // Workers may still be meshing for the world or the far terrain
+    JobSystem::Shutdown();
+
+    // The world and its renderer are members and outlive this, so their GL
+    // objects go now, while the context is still current
+    m_WorldRenderer.Shutdown();
+    GpuProfiler::Shutdown();
     SDL_GL_DeleteContext(m_GLContext);
     SDL_DestroyWindow(m_Window);
     SDL_Quit();
@@ -1,5 +1,5 @@
 #include "core/Camera.hpp"
-#include "core/Input.hpp"
+#include <cmath>
 
 Camera::Camera()
     : Position(glm::vec3(0.0f)), WorldUp(glm::vec3(0.0f, 1.0f, 0.0f)),
@@ -13,17 +13,16 @@ glm::mat4 Camera::GetViewMatrix() const {
 }
 
 glm::mat4 Camera::GetProjectionMatrix(float width, float height) const {
-    return glm::perspective(glm::radians(Zoom), width / height, 0.1f, 1000.0f);
+    // Far plane reaches past the LOD horizon
+    return glm::perspective(glm::radians(Zoom), width / height, 0.1f, 2000.0f);
 }
 
 glm::vec3 Camera::GetPosition() const {
     return Position;
 }
 
-void Camera::Update(float deltaTime) {
+void Camera::Update(glm::vec2 mouseDelta) {
     // Handle Mouse Rotation
-    glm::vec2 mouseDelta = Input::GetMouseDelta();
-
     Yaw += mouseDelta.x * MouseSensitivity;
     Pitch -= mouseDelta.y * MouseSensitivity;
 
@@ -36,6 +35,12 @@ void Camera::Update(float deltaTime) {
     updateCameraVectors();
 }
 
+void Camera::SetRotation(float yaw, float pitch) {
+    Yaw = yaw;
+    Pitch = pitch;
+    updateCameraVectors();
+}
+
 void Camera::updateCameraVectors() {
     // Calculate the new Front vector
     glm::vec3 front;
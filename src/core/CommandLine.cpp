@@ -0,0 +1,49 @@
+#include "core/CommandLine.hpp"
+
+#include <cstdlib>
+
+void CommandLine::Parse(int argc, char** argv) {
+    m_Args.clear();
+    for (int i = 1; i < argc; i++) {
+        m_Args.push_back(argv[i]);
+    }
+}
+
+bool CommandLine::HasFlag(const std::string& name) {
+    for (const std::string& arg : m_Args) {
+        if (arg == name || arg.rfind(name + "=", 0) == 0)
+            return true;
+    }
+    return false;
+}
+
+bool CommandLine::findValue(const std::string& name, std::string& value) {
+    for (size_t i = 0; i < m_Args.size(); i++) {
+        const std::string& arg = m_Args[i];
+        if (arg.rfind(name + "=", 0) == 0) {
+            value = arg.substr(name.size() + 1);
+            return true;
+        }
+        if (arg == name && i + 1 < m_Args.size()) {
+            value = m_Args[i + 1];
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string CommandLine::GetString(const std::string& name,
+                                   const std::string& fallback) {
+    std::string value;
+    return findValue(name, value) ? value : fallback;
+}
+
+int CommandLine::GetInt(const std::string& name, int fallback) {
+    std::string value;
+    return findValue(name, value) ? std::atoi(value.c_str()) : fallback;
+}
+
+float CommandLine::GetFloat(const std::string& name, float fallback) {
+    std::string value;
+    return findValue(name, value) ? (float)std::atof(value.c_str()) : fallback;
+}
@@ -0,0 +1,88 @@
+#include "core/FrameArena.hpp"
+#include "core/MemoryTracker.hpp"
+
+#include <algorithm>
+
+namespace {
+// Smallest block the arena asks the heap for
+const size_t FRAME_ARENA_BLOCK_SIZE = 256 * 1024;
+} // namespace
+
+FrameArena::~FrameArena() {
+    for (Block& block : m_Blocks) {
+        MemoryTracker::Remove(MemoryCategory::FrameArenas, block.size);
+        delete[] block.data;
+    }
+}
+
+FrameArena& FrameArena::Get() {
+    thread_local FrameArena arena;
+    return arena;
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment) {
+    if (m_Blocks.empty())
+        addBlock(size + alignment);
+
+    // Align the address, not the offset; blocks are only max_align_t
+    // aligned themselves
+    auto alignedOffset = [&](const Block& block, size_t offset) {
+        uintptr_t base = (uintptr_t)block.data;
+        uintptr_t address = (base + offset + alignment - 1) & ~(alignment - 1);
+        return (size_t)(address - base);
+    };
+
+    size_t offset = alignedOffset(m_Blocks.back(), m_Offset);
+    if (offset + size > m_Blocks.back().size) {
+        addBlock(size + alignment);
+        offset = alignedOffset(m_Blocks.back(), 0);
+    }
+
+    m_Used += offset - m_Offset + size;
+    m_Peak = std::max(m_Peak, m_Used);
+    m_Offset = offset + size;
+    return m_Blocks.back().data + offset;
+}
+
+void FrameArena::Free(void* ptr, size_t size) {
+    if (m_Blocks.empty())
+        return;
+
+    uint8_t* top = m_Blocks.back().data + m_Offset;
+    if ((uint8_t*)ptr + size == top) {
+        m_Offset -= size;
+        m_Used -= size;
+    }
+}
+
+void FrameArena::Reset() {
+    // Overflowed this frame: swap the chain for one block that fits it all
+    if (m_Blocks.size() > 1) {
+        for (Block& block : m_Blocks) {
+            MemoryTracker::Remove(MemoryCategory::FrameArenas, block.size);
+            delete[] block.data;
+        }
+        m_Blocks.clear();
+        addBlock(m_Peak);
+    }
+
+    m_Offset = 0;
+    m_Used = 0;
+    m_Peak = 0;
+}
+
+size_t FrameArena::GetCapacity() const {
+    size_t total = 0;
+    for (const Block& block : m_Blocks)
+        total += block.size;
+    return total;
+}
+
+void FrameArena::addBlock(size_t minSize) {
+    Block block;
+    block.size = std::max(minSize, FRAME_ARENA_BLOCK_SIZE);
+    block.data = new uint8_t[block.size];
+    MemoryTracker::Add(MemoryCategory::FrameArenas, block.size);
+    m_Blocks.push_back(block);
+    m_Offset = 0;
+}
@@ -0,0 +1,506 @@
+#include "core/HeadlessApplication.hpp"
+#include "core/CommandLine.hpp"
+#include "core/FrameArena.hpp"
+#include "core/JobSystem.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/Profiler.hpp"
+#include "core/TraceCapture.hpp"
+#include "game/network/NetworkSession.hpp"
+#include "game/network/LoopbackTransport.hpp"
+#include "game/network/NetworkStats.hpp"
+#include "game/network/RemotePlayerStore.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// World::Init loads a 4x4 chunk area starting at the origin
+const float WORLD_EXTENT = 4.0f * CHUNK_SIZE;
+
+// Bots turn back before they walk off the loaded chunks
+const float WORLD_MARGIN = 3.0f;
+
+// The server's slot; bots take the ones after it
+const uint8_t HOST_SLOT = 0;
+
+const int DEFAULT_UDP_PORT = 27015;
+
+void onSignal(int) {
+    HeadlessApplication::RequestStop();
+}
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Players spread over the chunk grid by slot, dropping in from above
+glm::vec3 spawnPoint(uint8_t slot) {
+    int i = slot - HOST_SLOT - 1;
+    return glm::vec3(
+        8.0f + (i % 4) * CHUNK_SIZE, 30.0f, 8.0f + (i / 4 % 4) * CHUNK_SIZE);
+}
+} // namespace
+
+HeadlessApplication::HeadlessApplication() {}
+
+HeadlessApplication::~HeadlessApplication() {
+    // Finish in-flight mesh jobs before the world goes away
+    JobSystem::Shutdown();
+    NetworkSession::SetTransport(nullptr);
+    NetworkSession::Reset();
+    RemotePlayerStore::Clear();
+}
+
+void HeadlessApplication::RequestStop() {
+    s_StopRequested = 1;
+}
+
+bool HeadlessApplication::initialize() {
+    std::signal(SIGINT, onSignal);
+
+    m_TickLimit = CommandLine::GetInt("--ticks", 0);
+    m_Unthrottled = CommandLine::HasFlag("--unthrottled");
+    int botCount = CommandLine::GetInt("--bots", 4);
+    if (botCount < 0 || botCount >= MAX_SESSION_PLAYERS) {
+        std::cerr << "[Headless] --bots must be between 0 and "
+                  << MAX_SESSION_PLAYERS - 1 << std::endl;
+        return false;
+    }
+
+    int simulationRate = CommandLine::GetInt("--sim-rate", 60);
+    if (simulationRate <= 0 || simulationRate > MAX_SIMULATION_RATE) {
+        std::cerr << "[Headless] --sim-rate must be between 1 and "
+                  << MAX_SIMULATION_RATE << std::endl;
+        return false;
+    }
+    m_SimulationRate = (float)simulationRate;
+    NetworkSession::SetSimulationRate(simulationRate);
+
+    std::string server = CommandLine::GetString("--connect");
+    std::string transport = CommandLine::GetString(
+        "--transport", server.empty() ? "loopback" : "udp");
+    int port = CommandLine::GetInt("--port", DEFAULT_UDP_PORT);
+    bool udp = transport == "udp";
+    if (!udp && transport != "loopback") {
+        std::cerr << "[Headless] Unknown transport " << transport
+                  << ", expected loopback or udp" << std::endl;
+        return false;
+    }
+    if (!server.empty() && !udp) {
+        std::cerr << "[Headless] --connect needs the udp transport"
+                  << std::endl;
+        return false;
+    }
+
+    Profiler::SetThreadName("Main");
+    JobSystem::Init();
+
+    // World has no GL state of its own; only the client's WorldRenderer does
+    m_World.Init();
+
+    NetworkConditions conditions = NetworkConditions::FromCommandLine();
+    uint32_t netSeed = (uint32_t)CommandLine::GetInt("--net-seed", 1);
+
+    // Serve the session unless we are only here to load someone else's
+    m_Hosting = server.empty();
+    if (m_Hosting) {
+        if (udp) {
+            auto host = std::make_unique<UdpTransport>();
+            if (!host->Listen((uint16_t)port, HOST_SLOT))
+                return false;
+            m_Udp = host.get();
+            m_Transport = std::move(host);
+        } else {
+            m_Transport = std::make_unique<LoopbackTransport>(HOST_SLOT);
+        }
+        m_Network =
+            std::make_unique<SimulatedTransport>(*m_Transport, netSeed);
+        m_Network->SetConditions(conditions);
+        NetworkSession::SetTransport(m_Network.get());
+        NetworkSession::SetLocalSlot(HOST_SLOT);
+        NetworkSession::SetHostSlot(HOST_SLOT);
+    }
+
+    // Over loopback the bots are handed their slots; over UDP they ask the
+    // server and wait. IDs only have to differ between processes for UDP.
+    std::random_device device;
+    m_Bots.resize(botCount);
+    for (int i = 0; i < botCount; i++) {
+        Bot& bot = m_Bots[i];
+        bot.id = (uint64_t)(i + 1);
+        bot.rng.seed((uint32_t)bot.id);
+        if (udp) {
+            bot.id |= (uint64_t)device() << 32;
+            auto client = std::make_unique<UdpTransport>();
+            if (!client->Connect(server.empty() ? "127.0.0.1" : server,
+                                 (uint16_t)port,
+                                 bot.id))
+                return false;
+            bot.udp = client.get();
+            bot.transport = std::move(client);
+        } else {
+            bot.slot = (uint8_t)(HOST_SLOT + 1 + i);
+            bot.hostSlot = HOST_SLOT;
+            bot.transport = std::make_unique<LoopbackTransport>(bot.slot);
+        }
+        bot.network = std::make_unique<SimulatedTransport>(
+            *bot.transport, netSeed + 1 + (uint32_t)i);
+        bot.network->SetConditions(conditions);
+        if (udp)
+            continue;
+
+        NetworkSession::AssignSlot(bot.slot, bot.id);
+        bot.player.Position = spawnPoint(bot.slot);
+        bot.player.PreviousPosition = bot.player.Position;
+        NetworkSession::GetAuthority(bot.slot).Spawn(bot.player.Position);
+    }
+
+    int traceFrames = CommandLine::GetInt("--trace", 0);
+    if (traceFrames > 0)
+        TraceCapture::Begin(traceFrames,
+                            CommandLine::GetString("--trace-file"));
+
+    std::cout << "[Headless] " << m_World.GetChunkCount() << " chunks, "
+              << botCount << " bots over " << transport << ", "
+              << m_SimulationRate << " Hz"
+              << (m_Unthrottled ? " (unthrottled)" : "")
+              << (m_Hosting ? "" : ", bots only") << std::endl;
+    if (!conditions.IsIdeal())
+        std::cout << "[Headless] Simulating " << conditions.latencyMs
+                  << " +/- " << conditions.jitterMs << " ms one way, "
+                  << conditions.lossPercent << "% loss, "
+                  << conditions.duplicatePercent << "% duplicated, "
+                  << conditions.reorderPercent << "% reordered" << std::endl;
+    return true;
+}
+
+int HeadlessApplication::Run() {
+    if (!initialize())
+        return -1;
+
+    const double step = 1.0 / m_SimulationRate;
+    const Clock::time_point start = Clock::now();
+    Clock::time_point last = start;
+    Clock::time_point statsStart = start;
+    double accumulator = 0.0;
+
+    while (!s_StopRequested) {
+        Profiler::BeginFrame();
+
+        Clock::time_point now = Clock::now();
+        double frameTime = std::chrono::duration<double>(now - last).count();
+        last = now;
+
+        if (m_Unthrottled) {
+            // Exactly one step per frame, as if time kept up perfectly
+            fixedUpdate((float)step);
+            frameTime = step;
+        } else {
+            // Same fixed-step loop as the client
+            accumulator += frameTime;
+            int steps = 0;
+            while (accumulator >= step && steps < m_MaxSimulationSteps) {
+                fixedUpdate((float)step);
+                accumulator -= step;
+                steps++;
+            }
+            if (accumulator >= step)
+                accumulator = 0.0;
+        }
+
+        update((float)frameTime);
+        FrameArena::Get().Reset();
+        Profiler::EndFrame();
+        m_StatsFrames++;
+        m_StatsAllocations += Profiler::GetLastFrameAllocations();
+
+        if (m_TickLimit > 0 && m_Ticks >= m_TickLimit)
+            break;
+
+        double sinceStats = secondsSince(statsStart);
+        if (sinceStats >= 1.0) {
+            printStats(sinceStats);
+            statsStart = Clock::now();
+        }
+
+        // Nothing to draw, so sleep until the next step is due
+        if (!m_Unthrottled) {
+            auto untilStep =
+                std::chrono::duration<double>(step - accumulator);
+            std::this_thread::sleep_until(
+                last + std::chrono::duration_cast<Clock::duration>(untilStep));
+        }
+    }
+
+    std::cout << "[Headless] Stopped after " << m_Ticks << " ticks in "
+              << secondsSince(start) << " s" << std::endl;
+    return 0;
+}
+
+void HeadlessApplication::fixedUpdate(float step) {
+    ORIX_PROFILE_ZONE("HeadlessApplication::FixedUpdate");
+    Clock::time_point begin = Clock::now();
+
+    receiveMessages();
+    for (Bot& bot : m_Bots) {
+        if (bot.slot != NO_PLAYER_SLOT)
+            updateBot(bot, step);
+    }
+    NetworkSession::SimulateClients(m_World, step);
+
+    // Network tick
+    const float tickInterval = 1.0f / m_NetworkTickrate;
+
+    m_NetworkTimer += step;
+    if (m_NetworkTimer >= tickInterval) {
+        sendPositions();
+        m_NetworkTimer -= tickInterval;
+    }
+
+    m_Ticks++;
+    m_StatsTicks++;
+    m_StatsStepTime += secondsSince(begin);
+}
+
+void HeadlessApplication::update(float deltaTime) {
+    ORIX_PROFILE_ZONE("HeadlessApplication::Update");
+
+    RemotePlayerStore::Interpolate(deltaTime);
+
+    // Edits from this frame's steps get meshed on the job system as usual
+    m_World.Update(deltaTime);
+    MemoryTracker::Update();
+    NetworkStats::Update();
+}
+
+void HeadlessApplication::updateBot(Bot& bot, float step) {
+    Player& player = bot.player;
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    if (--bot.nextDecision <= 0) {
+        std::uniform_real_distribution<float> yaw(-180.0f, 180.0f);
+        std::uniform_int_distribution<int> duration(60, 180);
+        player.Yaw = yaw(bot.rng);
+        bot.input.forward = percent(bot.rng) < 80;
+        bot.nextDecision = duration(bot.rng);
+    }
+
+    // Head back towards the middle near the edge of the loaded area
+    glm::vec3 pos = player.Position;
+    if (pos.x < WORLD_MARGIN || pos.z < WORLD_MARGIN ||
+        pos.x > WORLD_EXTENT - WORLD_MARGIN ||
+        pos.z > WORLD_EXTENT - WORLD_MARGIN) {
+        glm::vec3 toCenter =
+            glm::vec3(WORLD_EXTENT * 0.5f, pos.y, WORLD_EXTENT * 0.5f) - pos;
+        player.Yaw = glm::degrees(atan2(toCenter.z, toCenter.x));
+    }
+
+    bot.input.jump = percent(bot.rng) < 2;
+    bot.prediction.Step(player, m_World, bot.input, step);
+
+    if (--bot.nextEdit <= 0) {
+        std::uniform_int_distribution<int> delay(90, 240);
+        editBlock(bot);
+        bot.nextEdit = delay(bot.rng);
+    }
+}
+
+void HeadlessApplication::editBlock(Bot& bot) {
+    // Alternate digging a block and putting it back, so a long soak test
+    // keeps relighting and remeshing without eating the world
+    if (bot.hasDug) {
+        m_World.SetBlockAt(
+            bot.dugPos.x, bot.dugPos.y, bot.dugPos.z, bot.dugType);
+        bot.hasDug = false;
+        m_StatsEdits++;
+        return;
+    }
+
+    Player& player = bot.player;
+    float yaw = glm::radians(player.Yaw);
+    glm::vec3 eye = player.Position + glm::vec3(0.0f, player.Height, 0.0f);
+    glm::vec3 dir = glm::normalize(glm::vec3(cos(yaw), -1.0f, sin(yaw)));
+
+    glm::ivec3 hit, normal;
+    if (!m_World.Raycast(eye, dir, 6.0f, hit, normal))
+        return;
+
+    bot.dugPos = hit;
+    bot.dugType = m_World.GetBlockAt(hit.x, hit.y, hit.z).type;
+    bot.hasDug = true;
+    m_World.SetBlockAt(hit.x, hit.y, hit.z, BlockType::Air);
+    m_StatsEdits++;
+}
+
+void HeadlessApplication::receiveMessages() {
+    if (m_Hosting) {
+        NetworkSession::Receive();
+
+        // UDP clients come and go on their own
+        UdpConnectionEvent event;
+        while (m_Udp && m_Udp->PollEvent(event)) {
+            if (!event.connected) {
+                NetworkSession::ReleaseSlot(event.slot);
+                continue;
+            }
+            NetworkSession::AssignSlot(event.slot, event.playerID);
+            NetworkSession::GetAuthority(event.slot)
+                .Spawn(spawnPoint(event.slot));
+        }
+    }
+
+    for (Bot& bot : m_Bots) {
+        TransportMessage message;
+        while (bot.network->Receive(message))
+            deliverToBot(bot, message.sender, message.data, message.size);
+
+        UdpConnectionEvent event;
+        while (bot.udp && bot.udp->PollEvent(event)) {
+            bot.prediction.Reset();
+            bot.decoder.Reset();
+            bot.outbox.Clear();
+            if (!event.connected) {
+                bot.slot = NO_PLAYER_SLOT;
+                continue;
+            }
+
+            // Where the server will have put it too
+            bot.slot = event.slot;
+            bot.hostSlot = bot.udp->GetHostSlot();
+            bot.player.Position = spawnPoint(bot.slot);
+            bot.player.PreviousPosition = bot.player.Position;
+            bot.player.Velocity = glm::vec3(0.0f);
+        }
+    }
+}
+
+void HeadlessApplication::sendPositions() {
+    // Each bot sends the host its unconfirmed inputs plus acks for what
+    // the host sent it, exactly as a remote client would
+    for (Bot& bot : m_Bots) {
+        if (bot.slot == NO_PLAYER_SLOT)
+            continue;
+
+        if (bot.prediction.WriteCommands(
+                bot.slot, (int)m_SimulationRate, m_PacketBuffer) &&
+            !bot.outbox.Add(m_PacketBuffer.data(), m_PacketBuffer.size())) {
+            bot.network->Send(
+                bot.hostSlot, bot.outbox.GetData(), bot.outbox.GetSize());
+            bot.outbox.Clear();
+            bot.outbox.Add(m_PacketBuffer.data(), m_PacketBuffer.size());
+        }
+
+        if (!bot.outbox.IsEmpty())
+            bot.network->Send(
+                bot.hostSlot, bot.outbox.GetData(), bot.outbox.GetSize());
+        bot.outbox.Clear();
+    }
+
+    // The host answers every bot with one snapshot of everybody
+    if (m_Hosting)
+        NetworkSession::SendTick();
+}
+
+void HeadlessApplication::deliverToBot(Bot& bot,
+                                       uint8_t sender,
+                                       const void* data,
+                                       size_t size) {
+    // Like a real client, only the host gets to say anything
+    if (sender != bot.hostSlot)
+        return;
+
+    PacketBatch::ForEach(data, size, [&](const void* packet, size_t length) {
+        PacketType type = *(const PacketType*)packet;
+        if (type == PacketType::PlayerCorrection &&
+            length >= sizeof(PlayerCorrectionPacket)) {
+            PlayerCorrectionPacket correction;
+            std::memcpy(&correction, packet, sizeof(correction));
+            bot.prediction.ApplyCorrection(correction);
+        } else if (type == PacketType::PlayerState) {
+            BitReader reader(packet, length);
+            reader.Read(8 + PLAYER_SLOT_BITS); // Type and sender
+            bool newest = false;
+            const Snapshot* snapshot = bot.decoder.Read(reader, newest);
+            if (!snapshot)
+                return;
+
+            StateAckPacket ack;
+            ack.slot = bot.slot;
+            ack.sequence = snapshot->sequence;
+            bot.outbox.Add(&ack, sizeof(ack));
+        }
+    });
+}
+
+void HeadlessApplication::printStats(double elapsed) {
+    double tickRate = m_StatsTicks / elapsed;
+    double stepMs =
+        m_StatsTicks > 0 ? m_StatsStepTime * 1000.0 / m_StatsTicks : 0.0;
+    double packetRate = RemotePlayerStore::GetAndResetPacketCount() / elapsed;
+
+    std::cout << "[Headless] tick " << m_Ticks << ": " << (int)tickRate
+              << " ticks/s, " << stepMs << " ms/step, " << (int)packetRate
+              << " packets/s, " << m_StatsEdits << " edits, "
+              << RemotePlayerStore::GetCount() << " remote players";
+
+    // UDP bots may still be waiting for the server, or have lost it
+    int connected = 0;
+    for (const Bot& bot : m_Bots)
+        connected += bot.slot != NO_PLAYER_SLOT ? 1 : 0;
+    if (connected < (int)m_Bots.size() || !m_Hosting)
+        std::cout << ", " << connected << "/" << m_Bots.size()
+                  << " bots connected";
+
+    // What each player costs the host on the wire, in and out, and what
+    // the same states would cost unpacked
+    const NetworkRates& rates = NetworkStats::GetRates();
+    int players = RemotePlayerStore::GetCount();
+    if (players > 0)
+        std::cout << ", " << (int)(rates.bytesReceived / players) << "/"
+                  << (int)(rates.bytesSent / players)
+                  << " B/player/s in/out (uncompressed "
+                  << (int)(rates.statesReceived * UNCOMPRESSED_STATE_BYTES /
+                           players)
+                  << "/"
+                  << (int)(rates.statesSent * UNCOMPRESSED_STATE_BYTES /
+                           players)
+                  << ")";
+    if (players > 0)
+        std::cout << ", buffer depth "
+                  << RemotePlayerStore::GetAverageBufferDepth() << ", "
+                  << RemotePlayerStore::GetLateStates() << " late";
+
+    // Bots whose prediction the host disagreed with since the last report
+    int64_t corrections = 0;
+    for (const Bot& bot : m_Bots)
+        corrections += bot.prediction.GetCorrections();
+    if (!m_Bots.empty())
+        std::cout << ", " << corrections - m_StatsCorrections
+                  << " corrections";
+    m_StatsCorrections = corrections;
+
+    // What the simulated network did to the host's own traffic
+    if (m_Network && !m_Network->GetConditions().IsIdeal()) {
+        const NetworkSimulationStats& network = m_Network->GetStats();
+        std::cout << ", " << network.dropped << "/" << network.sent
+                  << " host messages dropped, " << network.inFlight
+                  << " in flight";
+    }
+#ifdef ORIX_PROFILING
+    if (m_StatsFrames > 0)
+        std::cout << ", " << (double)m_StatsAllocations / m_StatsFrames
+                  << " allocs/frame";
+#endif
+    std::cout << std::endl;
+
+    m_StatsTicks = 0;
+    m_StatsFrames = 0;
+    m_StatsAllocations = 0;
+    m_StatsStepTime = 0.0;
+    m_StatsEdits = 0;
+}
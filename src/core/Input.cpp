@@ -1,6 +1,22 @@
 #include "core/Input.hpp"
+#include "core/InputRecorder.hpp"
+#include <algorithm>
+#include <cstring>
+
+void Input::Update(float frameTime) {
+    m_FrameTime = frameTime;
+
+    if (InputRecorder::IsReplaying()) {
+        replayFrame();
+        return;
+    }
+
+    // Whatever the replay left held down is released
+    if (m_WasReplaying) {
+        m_KeyboardState = nullptr;
+        m_WasReplaying = false;
+    }
 
-void Input::Update() {
     // Get current keyboard state first
     const uint8_t* currentKeyboardState = SDL_GetKeyboardState(NULL);
 
@@ -17,6 +33,69 @@ void Input::Update() {
     int x, y;
     m_MouseState = SDL_GetRelativeMouseState(&x, &y);
     m_MouseDelta = glm::vec2((float)x, (float)y);
+
+    if (InputRecorder::IsRecording())
+        recordFrame();
+}
+
+void Input::recordFrame() {
+    InputFrame frame;
+    frame.deltaTime = m_FrameTime;
+    auto toInt16 = [](float v) {
+        return (int16_t)std::clamp(v, -32768.0f, 32767.0f);
+    };
+    frame.mouseDeltaX = toInt16(m_MouseDelta.x);
+    frame.mouseDeltaY = toInt16(m_MouseDelta.y);
+    frame.mouseButtons = (uint8_t)m_MouseState;
+
+    // Only keys that changed since the last recorded frame are stored. The
+    // baseline starts all up, like the replay does.
+    if (InputRecorder::GetFrameCount() == 0)
+        memset(m_RecordedKeyboardState, 0, SDL_NUM_SCANCODES);
+    for (int key = 0; key < SDL_NUM_SCANCODES; key++) {
+        uint8_t down = m_KeyboardState[key] ? 1 : 0;
+        if (down == m_RecordedKeyboardState[key])
+            continue;
+        m_RecordedKeyboardState[key] = down;
+        frame.keyChanges.push_back(
+            (uint16_t)(key | (down ? INPUT_KEY_DOWN_BIT : 0)));
+    }
+
+    InputRecorder::RecordFrame(frame);
+}
+
+void Input::replayFrame() {
+    // Keep SDL's relative mouse state drained so the real mouse doesn't jump
+    // the camera once the replay ends
+    int x, y;
+    SDL_GetRelativeMouseState(&x, &y);
+
+    if (!m_WasReplaying) {
+        memset(m_RecordedKeyboardState, 0, SDL_NUM_SCANCODES);
+        m_KeyboardState = m_RecordedKeyboardState;
+        m_WasReplaying = true;
+    }
+    memcpy(m_PrevKeyboardState, m_RecordedKeyboardState, SDL_NUM_SCANCODES);
+    m_PrevMouseState = m_MouseState;
+
+    InputFrame frame;
+    if (!InputRecorder::ReadFrame(frame)) {
+        // Out of frames: release everything and hand back to SDL next time
+        memset(m_RecordedKeyboardState, 0, SDL_NUM_SCANCODES);
+        m_MouseState = 0;
+        m_MouseDelta = glm::vec2(0.0f);
+        return;
+    }
+
+    for (uint16_t change : frame.keyChanges) {
+        uint16_t key = change & ~INPUT_KEY_DOWN_BIT;
+        if (key < SDL_NUM_SCANCODES)
+            m_RecordedKeyboardState[key] =
+                (change & INPUT_KEY_DOWN_BIT) ? 1 : 0;
+    }
+    m_MouseState = frame.mouseButtons;
+    m_MouseDelta = glm::vec2(frame.mouseDeltaX, frame.mouseDeltaY);
+    m_FrameTime = frame.deltaTime;
 }
 
 bool Input::IsKeyDown(SDL_Scancode key) {
@@ -0,0 +1,160 @@
+#include "core/InputRecorder.hpp"
+
+#include <iostream>
+
+namespace {
+
+const uint32_t RECORDING_MAGIC = 0x4958524F; // "ORXI" in file order
+const uint16_t RECORDING_VERSION = 1;
+
+#pragma pack(push, 1)
+struct RecordingHeader {
+    uint32_t magic;
+    uint16_t version;
+    int32_t seed;
+    float simulationRate;
+    float position[3];
+    float velocity[3];
+    float yaw;
+    float pitch;
+    uint8_t grounded;
+};
+
+struct FrameHeader {
+    float deltaTime;
+    int16_t mouseDeltaX;
+    int16_t mouseDeltaY;
+    uint8_t mouseButtons;
+    uint8_t keyChangeCount;
+};
+#pragma pack(pop)
+
+} // namespace
+
+bool InputRecorder::BeginRecording(const std::string& path,
+                                   const InputRecordingStart& start) {
+    EndRecording();
+
+    m_Output.open(path, std::ios::binary);
+    if (!m_Output) {
+        std::cerr << "[InputRecorder] Could not open " << path << std::endl;
+        return false;
+    }
+
+    RecordingHeader header;
+    header.magic = RECORDING_MAGIC;
+    header.version = RECORDING_VERSION;
+    header.seed = start.seed;
+    header.simulationRate = start.simulationRate;
+    for (int i = 0; i < 3; i++) {
+        header.position[i] = start.position[i];
+        header.velocity[i] = start.velocity[i];
+    }
+    header.yaw = start.yaw;
+    header.pitch = start.pitch;
+    header.grounded = start.grounded ? 1 : 0;
+    m_Output.write((const char*)&header, sizeof(header));
+
+    m_FrameCount = 0;
+    std::cout << "[InputRecorder] Recording to " << path << std::endl;
+    return true;
+}
+
+void InputRecorder::RecordFrame(const InputFrame& frame) {
+    if (!m_Output.is_open())
+        return;
+
+    // A keyboard can't change 255 keys in one frame; anything past that is
+    // dropped rather than widening every frame
+    size_t keyCount = frame.keyChanges.size();
+    if (keyCount > 255)
+        keyCount = 255;
+
+    FrameHeader header;
+    header.deltaTime = frame.deltaTime;
+    header.mouseDeltaX = frame.mouseDeltaX;
+    header.mouseDeltaY = frame.mouseDeltaY;
+    header.mouseButtons = frame.mouseButtons;
+    header.keyChangeCount = (uint8_t)keyCount;
+    m_Output.write((const char*)&header, sizeof(header));
+    m_Output.write((const char*)frame.keyChanges.data(),
+                   keyCount * sizeof(uint16_t));
+
+    m_FrameCount++;
+}
+
+void InputRecorder::EndRecording() {
+    if (!m_Output.is_open())
+        return;
+
+    m_Output.close();
+    std::cout << "[InputRecorder] Recorded " << m_FrameCount << " frames"
+              << std::endl;
+}
+
+bool InputRecorder::BeginReplay(const std::string& path,
+                                InputRecordingStart& start) {
+    EndReplay();
+
+    m_Input.open(path, std::ios::binary);
+    if (!m_Input) {
+        std::cerr << "[InputRecorder] Could not open " << path << std::endl;
+        return false;
+    }
+
+    RecordingHeader header;
+    if (!m_Input.read((char*)&header, sizeof(header)) ||
+        header.magic != RECORDING_MAGIC ||
+        header.version != RECORDING_VERSION ||
+        !(header.simulationRate > 0.0f)) {
+        std::cerr << "[InputRecorder] " << path
+                  << " is not a supported input recording" << std::endl;
+        m_Input.close();
+        return false;
+    }
+
+    start.seed = header.seed;
+    start.simulationRate = header.simulationRate;
+    for (int i = 0; i < 3; i++) {
+        start.position[i] = header.position[i];
+        start.velocity[i] = header.velocity[i];
+    }
+    start.yaw = header.yaw;
+    start.pitch = header.pitch;
+    start.grounded = header.grounded != 0;
+
+    m_FrameCount = 0;
+    std::cout << "[InputRecorder] Replaying " << path << std::endl;
+    return true;
+}
+
+bool InputRecorder::ReadFrame(InputFrame& frame) {
+    if (!m_Input.is_open())
+        return false;
+
+    FrameHeader header;
+    if (!m_Input.read((char*)&header, sizeof(header))) {
+        EndReplay();
+        return false;
+    }
+
+    frame.deltaTime = header.deltaTime;
+    frame.mouseDeltaX = header.mouseDeltaX;
+    frame.mouseDeltaY = header.mouseDeltaY;
+    frame.mouseButtons = header.mouseButtons;
+    frame.keyChanges.resize(header.keyChangeCount);
+    if (!m_Input.read((char*)frame.keyChanges.data(),
+                      header.keyChangeCount * sizeof(uint16_t))) {
+        // Truncated last frame, e.g. the recording app was killed
+        EndReplay();
+        return false;
+    }
+
+    m_FrameCount++;
+    return true;
+}
+
+void InputRecorder::EndReplay() {
+    if (m_Input.is_open())
+        m_Input.close();
+}
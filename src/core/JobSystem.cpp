@@ -0,0 +1,208 @@
+#include "core/JobSystem.hpp"
+#include "core/FrameArena.hpp"
+#include "core/Profiler.hpp"
+
+#include <algorithm>
+#include <string>
+
+void JobSystem::Init(int workerCount) {
+    if (!m_Queues.empty())
+        Shutdown();
+
+    if (workerCount <= 0)
+        workerCount = std::max((int)std::thread::hardware_concurrency() - 1, 1);
+
+    m_Stopping = false;
+    for (int i = 0; i <= workerCount; i++) {
+        m_Queues.push_back(std::make_unique<JobQueue>());
+    }
+
+    t_ThreadIndex = 0;
+    for (int i = 1; i <= workerCount; i++) {
+        m_Threads.emplace_back(&JobSystem::workerLoop, i);
+    }
+}
+
+void JobSystem::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_WakeMutex);
+        m_Stopping = true;
+    }
+    m_WakeCondition.notify_all();
+
+    for (auto& thread : m_Threads) {
+        if (thread.joinable())
+            thread.join();
+    }
+    m_Threads.clear();
+
+    // Anything still queued is finished on this thread so no counter is
+    // left waiting forever
+    while (runOneJob()) {
+    }
+    m_Queues.clear();
+}
+
+void JobSystem::Run(std::function<void()> job,
+                    JobCounter* counter,
+                    const JobCounter* dependency) {
+    if (counter)
+        counter->m_Count.fetch_add(1, std::memory_order_relaxed);
+
+    // Without workers the job just runs inline
+    if (m_Queues.empty()) {
+        if (dependency) {
+            while (!dependency->IsDone())
+                std::this_thread::yield();
+        }
+        job();
+        if (counter)
+            counter->m_Count.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+
+    push(t_ThreadIndex, Job{std::move(job), counter, dependency}, false);
+
+    // Taking the lock orders this with a worker that is about to sleep
+    { std::lock_guard<std::mutex> lock(m_WakeMutex); }
+    m_WakeCondition.notify_one();
+}
+
+void JobSystem::push(int index, Job job, bool front) {
+    JobQueue& queue = *m_Queues[index];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (front)
+            queue.PushFront(std::move(job));
+        else
+            queue.PushBack(std::move(job));
+    }
+    m_QueuedJobs.fetch_add(1, std::memory_order_release);
+}
+
+bool JobSystem::popJob(int index, Job& job) {
+    // Own work first, newest end, while it's still warm in cache
+    {
+        JobQueue& queue = *m_Queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.count > 0) {
+            job = queue.PopBack();
+            m_QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Then steal the oldest job from someone else
+    int count = (int)m_Queues.size();
+    for (int i = 1; i < count; i++) {
+        JobQueue& queue = *m_Queues[(index + i) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.count > 0) {
+            job = queue.PopFront();
+            m_QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool JobSystem::runOneJob() {
+    if (m_Queues.empty())
+        return false;
+
+    Job job;
+    if (!popJob(t_ThreadIndex, job))
+        return false;
+
+    // Not ready yet: park it at the far end of our own queue
+    if (job.dependency && !job.dependency->IsDone()) {
+        push(t_ThreadIndex, std::move(job), true);
+        std::this_thread::yield();
+        return true;
+    }
+
+    job.function();
+    if (job.counter)
+        job.counter->m_Count.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void JobSystem::Wait(const JobCounter& counter) {
+    while (!counter.IsDone()) {
+        if (!runOneJob())
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::ParallelFor(
+    int count,
+    int batchSize,
+    const std::function<void(int begin, int end)>& body) {
+    batchSize = std::max(batchSize, 1);
+
+    JobCounter counter;
+    for (int begin = 0; begin < count; begin += batchSize) {
+        int end = std::min(begin + batchSize, count);
+        Run([&body, begin, end] { body(begin, end); }, &counter);
+    }
+    Wait(counter);
+}
+
+void JobSystem::JobQueue::PushBack(Job job) {
+    if (count == ring.size())
+        grow();
+    ring[(head + count) % ring.size()] = std::move(job);
+    count++;
+}
+
+void JobSystem::JobQueue::PushFront(Job job) {
+    if (count == ring.size())
+        grow();
+    head = (head + ring.size() - 1) % ring.size();
+    ring[head] = std::move(job);
+    count++;
+}
+
+JobSystem::Job JobSystem::JobQueue::PopBack() {
+    count--;
+    return std::move(ring[(head + count) % ring.size()]);
+}
+
+JobSystem::Job JobSystem::JobQueue::PopFront() {
+    Job job = std::move(ring[head]);
+    head = (head + 1) % ring.size();
+    count--;
+    return job;
+}
+
+void JobSystem::JobQueue::grow() {
+    std::vector<Job> larger(std::max(ring.size() * 2, (size_t)64));
+    for (size_t i = 0; i < count; i++)
+        larger[i] = std::move(ring[(head + i) % ring.size()]);
+    ring = std::move(larger);
+    head = 0;
+}
+
+void JobSystem::workerLoop(int index) {
+    t_ThreadIndex = index;
+    Profiler::SetThreadName("Worker " + std::to_string(index));
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_WakeMutex);
+            m_WakeCondition.wait(lock, [] {
+                return m_Stopping || m_QueuedJobs.load() > 0;
+            });
+            if (m_Stopping)
+                return;
+        }
+
+        // A worker's frame is one job: nothing it put in its arena
+        // outlives the job. Jobs run inside Wait() don't get here, so a
+        // waiting job keeps its temporaries.
+        while (runOneJob()) {
+            FrameArena::Get().Reset();
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#include "core/MemoryTracker.hpp"
+
+namespace {
+const int64_t MB = 1024 * 1024;
+} // namespace
+
+// Defaults sized for the current 4x4 chunk world plus far LOD terrain,
+// with plenty of room; tighten them once streaming lands
+int64_t MemoryTracker::m_Budget[MEMORY_CATEGORY_COUNT] = {
+    256 * MB, // ChunkVoxels
+    256 * MB, // CpuMesh
+    512 * MB, // GpuBuffers
+    16 * MB,  // Noise
+    16 * MB,  // Network
+    64 * MB,  // UI
+    64 * MB,  // FrameArenas
+};
+
+void MemoryTracker::Add(MemoryCategory category, int64_t bytes) {
+    int index = (int)category;
+    int64_t current =
+        m_Current[index].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+    int64_t peak = m_Peak[index].load(std::memory_order_relaxed);
+    while (current > peak &&
+           !m_Peak[index].compare_exchange_weak(
+               peak, current, std::memory_order_relaxed)) {
+    }
+}
+
+const char* MemoryTracker::GetName(MemoryCategory category) {
+    switch (category) {
+    case MemoryCategory::ChunkVoxels:
+        return "Chunk voxels";
+    case MemoryCategory::CpuMesh:
+        return "CPU meshes";
+    case MemoryCategory::GpuBuffers:
+        return "GPU buffers";
+    case MemoryCategory::Noise:
+        return "Noise";
+    case MemoryCategory::Network:
+        return "Network";
+    case MemoryCategory::UI:
+        return "UI";
+    case MemoryCategory::FrameArenas:
+        return "Frame arenas";
+    default:
+        return "?";
+    }
+}
+
+int MemoryTracker::AddEvictionHook(MemoryCategory category, EvictionHook hook) {
+    int id = m_NextHookId++;
+    m_Hooks.push_back({id, category, std::move(hook)});
+    return id;
+}
+
+void MemoryTracker::RemoveEvictionHook(int id) {
+    for (auto it = m_Hooks.begin(); it != m_Hooks.end(); ++it) {
+        if (it->id == id) {
+            m_Hooks.erase(it);
+            return;
+        }
+    }
+}
+
+void MemoryTracker::Update() {
+    // By index: a hook may unregister itself
+    for (size_t i = 0; i < m_Hooks.size(); i++) {
+        Hook& hook = m_Hooks[i];
+        int64_t over = GetCurrent(hook.category) - GetBudget(hook.category);
+        if (over > 0)
+            hook.function(over);
+    }
+}
@@ -0,0 +1,196 @@
+#include "core/Profiler.hpp"
+#include "core/TraceCapture.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+// Profiling builds route the global heap through here so allocations can
+// be counted. The array and nothrow forms end up in these as well.
+#ifdef ORIX_PROFILING
+void* operator new(std::size_t size) {
+    Profiler::CountAllocation();
+    if (size == 0)
+        size = 1;
+    while (true) {
+        if (void* ptr = std::malloc(size))
+            return ptr;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+#endif
+
+uint64_t Profiler::Now() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+Profiler::ThreadBuffer& Profiler::threadBuffer() {
+    if (!t_Buffer) {
+        // Destroyed as the thread exits, which hands the buffer back
+        struct Registration {
+            ~Registration() {
+                releaseThreadBuffer();
+            }
+        };
+        thread_local Registration registration;
+
+        std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+        if (!m_FreeThreads.empty()) {
+            t_Buffer = m_FreeThreads.back();
+            m_FreeThreads.pop_back();
+        } else {
+            m_Threads.push_back(std::make_unique<ThreadBuffer>());
+            t_Buffer = m_Threads.back().get();
+            t_Buffer->index = m_Threads.size() - 1;
+        }
+        t_Buffer->name = "Thread " + std::to_string(t_Buffer->index);
+    }
+    return *t_Buffer;
+}
+
+void Profiler::releaseThreadBuffer() {
+    if (!t_Buffer)
+        return;
+
+    // Whatever it recorded last is still drained by the next EndFrame.
+    // The lane stays, but no longer under the exited thread's name.
+    std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+    t_Buffer->name = "Thread " + std::to_string(t_Buffer->index);
+    m_FreeThreads.push_back(t_Buffer);
+    t_Buffer = nullptr;
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+    buffer.name = name;
+}
+
+void Profiler::Record(const char* name,
+                      uint64_t start,
+                      uint64_t end,
+                      uint32_t allocations) {
+    ThreadBuffer& buffer = threadBuffer();
+
+    // Single producer: only this thread moves write, only the main thread
+    // moves read
+    uint64_t write = buffer.write.load(std::memory_order_relaxed);
+    uint64_t read = buffer.read.load(std::memory_order_acquire);
+    if (write - read >= RING_CAPACITY) {
+        m_DroppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.events[write % RING_CAPACITY] = {
+        name, start, end, t_Depth, allocations};
+    buffer.write.store(write + 1, std::memory_order_release);
+}
+
+void Profiler::AddCounter(const char* name, int64_t value) {
+    if (!IsEnabled())
+        return;
+
+    std::lock_guard<std::mutex> lock(m_CounterMutex);
+
+    // Looked up by string_view so a known counter doesn't build a string
+    auto it = m_Counters.find(std::string_view(name));
+    if (it == m_Counters.end()) {
+        t_IgnoreAllocations = true;
+        it = m_Counters.emplace(name, 0).first;
+        t_IgnoreAllocations = false;
+    }
+    it->second += value;
+}
+
+void Profiler::BeginFrame() {
+    m_FrameStart = Now();
+}
+
+void Profiler::EndFrame() {
+    t_IgnoreAllocations = true;
+
+    ProfileFrame frame;
+    frame.number = ++m_FrameNumber;
+    frame.start = m_FrameStart;
+    frame.end = Now();
+
+    uint64_t allocations = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+        for (auto& buffer : m_Threads) {
+            uint64_t count =
+                buffer->allocations.load(std::memory_order_relaxed);
+            allocations += count - buffer->reportedAllocations;
+            buffer->reportedAllocations = count;
+
+            ProfileThreadCapture capture;
+            capture.threadName = buffer->name;
+
+            uint64_t read = buffer->read.load(std::memory_order_relaxed);
+            uint64_t write = buffer->write.load(std::memory_order_acquire);
+            for (uint64_t i = read; i < write; i++) {
+                const ProfileEvent& event = buffer->events[i % RING_CAPACITY];
+                capture.events.push_back(event);
+                accumulate(event);
+            }
+            buffer->read.store(write, std::memory_order_release);
+
+            // Parents finish after their children; draw them first
+            std::sort(capture.events.begin(),
+                      capture.events.end(),
+                      [](const ProfileEvent& a, const ProfileEvent& b) {
+                          return a.start < b.start ||
+                                 (a.start == b.start && a.depth < b.depth);
+                      });
+            frame.threads.push_back(std::move(capture));
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_CounterMutex);
+        for (auto& [name, value] : m_Counters) {
+            frame.counters.push_back({name, value});
+            value = 0;
+        }
+    }
+    m_LastFrameAllocations = allocations;
+    frame.counters.push_back(
+        {"Heap Allocations", (int64_t)m_LastFrameAllocations});
+
+    TraceCapture::RecordFrame(frame);
+
+    if (!m_Paused)
+        m_LastFrame = std::move(frame);
+
+    if (++m_StatsFrames >= STATS_WINDOW_FRAMES) {
+        m_ShownStats = std::move(m_CollectingStats);
+        m_CollectingStats.clear();
+        m_StatsFrames = 0;
+    }
+
+    t_IgnoreAllocations = false;
+}
+
+void Profiler::accumulate(const ProfileEvent& event) {
+    ZoneStats& stats = m_CollectingStats[event.name];
+    uint64_t duration = event.end - event.start;
+    stats.minNs = std::min(stats.minNs, duration);
+    stats.maxNs = std::max(stats.maxNs, duration);
+    stats.totalNs += duration;
+    stats.allocations += event.allocations;
+    stats.calls++;
+}
@@ -23,6 +23,12 @@ void StateManager::ChangeState(std::unique_ptr<State> state) {
     m_States.back()->OnEnter(m_App);
 }
 
+void StateManager::FixedUpdate(float step) {
+    if (!m_States.empty()) {
+        m_States.back()->FixedUpdate(step, m_App);
+    }
+}
+
 void StateManager::Update(float deltaTime) {
     if (!m_States.empty()) {
         m_States.back()->Update(deltaTime, m_App);
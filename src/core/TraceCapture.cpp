@@ -0,0 +1,144 @@
+#include "core/TraceCapture.hpp"
+
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+// Zone names are code literals, but counters and thread names may not be
+std::string escape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+// Trace timestamps are microseconds
+double toMicros(uint64_t ns, uint64_t origin) {
+    return (double)(int64_t)(ns - origin) / 1000.0;
+}
+
+} // namespace
+
+void TraceCapture::Begin(int frameCount, const std::string& path) {
+    if (frameCount <= 0 || IsCapturing())
+        return;
+
+    m_Path = path;
+    if (m_Path.empty())
+        m_Path = "orix_trace_" + std::to_string(std::time(nullptr)) + ".json";
+
+    m_FramesLeft = frameCount;
+    m_Frames.clear();
+    m_GpuEvents.clear();
+    m_Frames.reserve(frameCount);
+
+    std::cout << "[TraceCapture] Recording " << frameCount << " frames to "
+              << m_Path << std::endl;
+}
+
+void TraceCapture::RecordFrame(const ProfileFrame& frame) {
+    if (!IsCapturing())
+        return;
+
+    m_Frames.push_back(frame);
+    if (--m_FramesLeft == 0)
+        write();
+}
+
+void TraceCapture::RecordGpuZone(const char* name,
+                                 uint64_t start,
+                                 uint64_t end) {
+    if (IsCapturing())
+        m_GpuEvents.push_back({name, start, end});
+}
+
+void TraceCapture::write() {
+    std::ofstream file(m_Path);
+    if (!file) {
+        std::cerr << "[TraceCapture] Failed to open " << m_Path << std::endl;
+        return;
+    }
+
+    // Long captures need more than the default 6 significant digits
+    file << std::fixed << std::setprecision(3);
+
+    uint64_t origin = m_Frames.empty() ? 0 : m_Frames.front().start;
+    const int cpuPid = 1;
+    const int gpuPid = 2;
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto begin = [&]() -> std::ofstream& {
+        if (!first)
+            file << ",\n";
+        first = false;
+        return file;
+    };
+
+    begin() << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << cpuPid
+            << ",\"args\":{\"name\":\"CPU\"}}";
+    begin() << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << gpuPid
+            << ",\"args\":{\"name\":\"GPU\"}}";
+
+    // Thread lanes keep the profiler's registration order
+    std::vector<std::string> threadNames;
+    for (const ProfileFrame& frame : m_Frames) {
+        for (size_t t = 0; t < frame.threads.size(); t++) {
+            if (t >= threadNames.size())
+                threadNames.push_back(frame.threads[t].threadName);
+        }
+    }
+    for (size_t t = 0; t < threadNames.size(); t++) {
+        begin() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << cpuPid
+                << ",\"tid\":" << t << ",\"args\":{\"name\":\""
+                << escape(threadNames[t]) << "\"}}";
+    }
+
+    for (const ProfileFrame& frame : m_Frames) {
+        begin() << "{\"name\":\"Frame " << frame.number
+                << "\",\"ph\":\"X\",\"pid\":" << cpuPid
+                << ",\"tid\":0,\"ts\":" << toMicros(frame.start, origin)
+                << ",\"dur\":" << (frame.end - frame.start) / 1000.0 << "}";
+
+        for (size_t t = 0; t < frame.threads.size(); t++) {
+            for (const ProfileEvent& event : frame.threads[t].events) {
+                begin() << "{\"name\":\"" << escape(event.name)
+                        << "\",\"ph\":\"X\",\"pid\":" << cpuPid
+                        << ",\"tid\":" << t
+                        << ",\"ts\":" << toMicros(event.start, origin)
+                        << ",\"dur\":" << (event.end - event.start) / 1000.0
+                        << ",\"args\":{\"allocations\":" << event.allocations
+                        << "}}";
+            }
+        }
+
+        for (const auto& [name, value] : frame.counters) {
+            begin() << "{\"name\":\"" << escape(name)
+                    << "\",\"ph\":\"C\",\"pid\":" << cpuPid
+                    << ",\"ts\":" << toMicros(frame.start, origin)
+                    << ",\"args\":{\"value\":" << value << "}}";
+        }
+    }
+
+    for (const GpuEvent& event : m_GpuEvents) {
+        if (event.start < origin)
+            continue;
+        begin() << "{\"name\":\"" << escape(event.name)
+                << "\",\"ph\":\"X\",\"pid\":" << gpuPid
+                << ",\"tid\":0,\"ts\":" << toMicros(event.start, origin)
+                << ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+    }
+
+    file << "\n]}\n";
+
+    std::cout << "[TraceCapture] Wrote " << m_Frames.size() << " frames to "
+              << m_Path << std::endl;
+    m_Frames.clear();
+    m_GpuEvents.clear();
+}
@@ -1,204 +1,362 @@
 #include "game/Chunk.hpp"
-#include <glad/glad.h>
-#include <glm/gtc/matrix_transform.hpp>
-#include "game/FastNoiseLite.h"
+#include "core/MemoryTracker.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include "game/World.hpp"
 
-Chunk::Chunk(glm::ivec3 position)
-    : m_WorldPos(position), m_VAO(0), m_VBO(0), m_VertexCount(0) {
-    FastNoiseLite noise;
-    noise.SetNoiseType(FastNoiseLite::NoiseType_Perlin);
-    noise.SetFrequency(0.05f);
+Chunk::Chunk(glm::ivec3 position) : m_WorldPos(position) {}
 
+Chunk::Chunk(glm::ivec3 position, const TerrainGenerator& terrain)
+    : m_WorldPos(position) {
+    Generate(terrain);
+}
+
+void Chunk::Generate(const TerrainGenerator& terrain) {
     for (int x = 0; x < CHUNK_SIZE; x++) {
         for (int z = 0; z < CHUNK_SIZE; z++) {
-            float worldX = (float)(m_WorldPos.x + x);
-            float worldZ = (float)(m_WorldPos.z + z);
-
-            float noiseValue = noise.GetNoise(worldX, worldZ);
-            int height = (int)((noiseValue + 1.0f) * 8.0f);
-
-            for (int y = 0; y < height; y++) {
-                if (y == height - 1) {
-                    // Top block is grass
-                    m_Blocks[x][y][z] = Block(BlockType::Grass);
-                } else if (y >= height - 4) {
-                    // Next 3 blocks down are dirt
-                    m_Blocks[x][y][z] = Block(BlockType::Dirt);
-                } else {
-                    // Everything below is stone
-                    m_Blocks[x][y][z] = Block(BlockType::Stone);
-                }
+            int height =
+                terrain.GetHeight(m_WorldPos.x + x, m_WorldPos.z + z);
+
+            for (int y = 0; y < CHUNK_SIZE; y++) {
+                m_Blocks[x][y][z] = Block(TerrainGenerator::GetBlockInColumn(
+                    m_WorldPos.y + y, height));
             }
         }
     }
 }
 
 Chunk::~Chunk() {
-    glDeleteVertexArrays(1, &m_VAO);
-    glDeleteBuffers(1, &m_VBO);
+    MemoryTracker::Remove(MemoryCategory::CpuMesh, GetMeshCapacityBytes());
 }
 
-void Chunk::GenerateMesh() {
-    std::vector<float> vertices;
+void Chunk::GenerateMesh(World& world) {
+    ORIX_PROFILE_ZONE("Chunk::GenerateMesh");
 
-    for (int x = 0; x < CHUNK_SIZE; x++) {
-        for (int y = 0; y < CHUNK_SIZE; y++) {
-            for (int z = 0; z < CHUNK_SIZE; z++) {
-                if (m_Blocks[x][y][z].type == BlockType::Air)
-                    continue;
-
-                glm::vec3 pos(x, y, z);
-                float blockType = static_cast<float>(m_Blocks[x][y][z].type);
-
-                // Face culling
-
-                // 0: Back (-Z)
-                if (z == 0 || m_Blocks[x][y][z - 1].type == BlockType::Air)
-                    addFace(vertices, pos, 0, blockType);
-
-                // 1: Front (+Z)
-                if (z == CHUNK_SIZE - 1 ||
-                    m_Blocks[x][y][z + 1].type == BlockType::Air)
-                    addFace(vertices, pos, 1, blockType);
-
-                // 2: Left (-X)
-                if (x == 0 || m_Blocks[x - 1][y][z].type == BlockType::Air)
-                    addFace(vertices, pos, 2, blockType);
-
-                // 3: Right (+X)
-                if (x == CHUNK_SIZE - 1 ||
-                    m_Blocks[x + 1][y][z].type == BlockType::Air)
-                    addFace(vertices, pos, 3, blockType);
-
-                // 4: Bottom (-Y)
-                if (y == 0 || m_Blocks[x][y - 1][z].type == BlockType::Air)
-                    addFace(vertices, pos, 4, blockType);
-
-                // 5: Top (+Y)
-                if (y == CHUNK_SIZE - 1 ||
-                    m_Blocks[x][y + 1][z].type == BlockType::Air)
-                    addFace(vertices, pos, 5, blockType);
+    ChunkNeighbourhood blocks;
+    GatherNeighbourhood(world, blocks);
+
+    ChunkMeshData data;
+    data.origin = m_WorldPos;
+    data.sectionMask = ALL_CHUNK_SECTIONS;
+    BuildMesh(blocks, s_MeshMode, data);
+
+    m_DirtySections = 0;
+    ApplyMesh(data);
+}
+
+void Chunk::ApplyMesh(ChunkMeshData& data) {
+    int64_t before = (int64_t)GetMeshCapacityBytes();
+    for (int s = 0; s < CHUNK_SECTION_COUNT; s++) {
+        if (data.sectionMask & (1u << s))
+            m_Sections[s].swap(data.sections[s]);
+    }
+    m_MeshVersion++;
+
+    MemoryTracker::Add(MemoryCategory::CpuMesh,
+                       (int64_t)GetMeshCapacityBytes() - before);
+}
+
+size_t Chunk::GetMeshCapacityBytes() const {
+    size_t total = 0;
+    for (const auto& section : m_Sections)
+        total += section.capacity() * sizeof(ChunkVertex);
+    return total;
+}
+
+int Chunk::GetVertexCount() const {
+    size_t total = 0;
+    for (const auto& section : m_Sections)
+        total += section.size();
+    return (int)total;
+}
+
+void Chunk::MarkDirty(int y) {
+    int lo = std::max(y - 1, 0);
+    int hi = std::min(y + 1, CHUNK_SIZE - 1);
+    for (int s = lo / CHUNK_SECTION_HEIGHT; s <= hi / CHUNK_SECTION_HEIGHT;
+         s++) {
+        m_DirtySections |= 1u << s;
+    }
+}
+
+void Chunk::GatherNeighbourhood(World& world, ChunkNeighbourhood& out) {
+    // Look the 27 chunks up once instead of once per block
+    Chunk* around[3][3][3];
+    for (int dx = 0; dx < 3; dx++) {
+        for (int dy = 0; dy < 3; dy++) {
+            for (int dz = 0; dz < 3; dz++) {
+                glm::ivec3 offset(dx - 1, dy - 1, dz - 1);
+                around[dx][dy][dz] =
+                    (offset == glm::ivec3(0))
+                        ? this
+                        : world.GetChunk(m_WorldPos + offset * CHUNK_SIZE);
+            }
+        }
+    }
+
+    // Which of the 3 chunks along an axis a padded coordinate falls into
+    auto slot = [](int v) {
+        return v < 0 ? 0 : (v < CHUNK_SIZE ? 1 : 2);
+    };
+
+    for (int x = -1; x <= CHUNK_SIZE; x++) {
+        int cx = slot(x);
+        int lx = x - (cx - 1) * CHUNK_SIZE;
+        for (int y = -1; y <= CHUNK_SIZE; y++) {
+            int cy = slot(y);
+            int ly = y - (cy - 1) * CHUNK_SIZE;
+            for (int z = -1; z <= CHUNK_SIZE; z++) {
+                int cz = slot(z);
+                int lz = z - (cz - 1) * CHUNK_SIZE;
+
+                // Missing neighbours count as open air, like the world edge
+                Chunk* chunk = around[cx][cy][cz];
+                if (chunk) {
+                    out.blocks[x + 1][y + 1][z + 1] =
+                        chunk->m_Blocks[lx][ly][lz].type;
+                    out.light[x + 1][y + 1][z + 1] = chunk->m_Light[lx][ly][lz];
+                } else {
+                    out.blocks[x + 1][y + 1][z + 1] = BlockType::Air;
+                    out.light[x + 1][y + 1][z + 1] = MAX_LIGHT_LEVEL << 4;
+                }
             }
         }
     }
+}
 
-    m_VertexCount =
-        vertices.size() / 6; // Now 6 floats per vertex (pos xyz, uv, blockID)
-
-    if (m_VAO == 0)
-        glGenVertexArrays(1, &m_VAO);
-    if (m_VBO == 0)
-        glGenBuffers(1, &m_VBO);
-
-    glBindVertexArray(m_VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferData(GL_ARRAY_BUFFER,
-                 vertices.size() * sizeof(float),
-                 vertices.data(),
-                 GL_STATIC_DRAW);
-
-    // Position attribute (location 0)
-    glVertexAttribPointer(
-        0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // Texture coordinate attribute (location 1)
-    glVertexAttribPointer(1,
-                          2,
-                          GL_FLOAT,
-                          GL_FALSE,
-                          6 * sizeof(float),
-                          (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // Block ID attribute (location 2)
-    glVertexAttribPointer(2,
-                          1,
-                          GL_FLOAT,
-                          GL_FALSE,
-                          6 * sizeof(float),
-                          (void*)(5 * sizeof(float)));
-    glEnableVertexAttribArray(2);
+namespace {
+
+// clang-format off
+// Face corners: 4 per face, 5 floats per corner (Pos X,Y,Z, U,V)
+const float FACE_CORNERS[6][4][5] = {
+    // Back face (face 0)
+    {{-0.5f, -0.5f, -0.5f,  0.0f, 0.0f},
+     { 0.5f, -0.5f, -0.5f,  1.0f, 0.0f},
+     { 0.5f,  0.5f, -0.5f,  1.0f, 1.0f},
+     {-0.5f,  0.5f, -0.5f,  0.0f, 1.0f}},
+
+    // Front face (face 1)
+    {{-0.5f, -0.5f,  0.5f,  0.0f, 0.0f},
+     { 0.5f, -0.5f,  0.5f,  1.0f, 0.0f},
+     { 0.5f,  0.5f,  0.5f,  1.0f, 1.0f},
+     {-0.5f,  0.5f,  0.5f,  0.0f, 1.0f}},
+
+    // Left face (face 2)
+    {{-0.5f,  0.5f,  0.5f,  1.0f, 0.0f},
+     {-0.5f,  0.5f, -0.5f,  1.0f, 1.0f},
+     {-0.5f, -0.5f, -0.5f,  0.0f, 1.0f},
+     {-0.5f, -0.5f,  0.5f,  0.0f, 0.0f}},
+
+    // Right face (face 3)
+    {{ 0.5f,  0.5f,  0.5f,  1.0f, 0.0f},
+     { 0.5f,  0.5f, -0.5f,  1.0f, 1.0f},
+     { 0.5f, -0.5f, -0.5f,  0.0f, 1.0f},
+     { 0.5f, -0.5f,  0.5f,  0.0f, 0.0f}},
+
+    // Bottom face (face 4)
+    {{-0.5f, -0.5f, -0.5f,  0.0f, 1.0f},
+     { 0.5f, -0.5f, -0.5f,  1.0f, 1.0f},
+     { 0.5f, -0.5f,  0.5f,  1.0f, 0.0f},
+     {-0.5f, -0.5f,  0.5f,  0.0f, 0.0f}},
+
+    // Top face (face 5)
+    {{-0.5f,  0.5f, -0.5f,  0.0f, 1.0f},
+     { 0.5f,  0.5f, -0.5f,  1.0f, 1.0f},
+     { 0.5f,  0.5f,  0.5f,  1.0f, 0.0f},
+     {-0.5f,  0.5f,  0.5f,  0.0f, 0.0f}}
+};
+// clang-format on
+
+// Outward normal of each face, in the same order as FACE_CORNERS
+const glm::ivec3 FACE_NORMALS[6] = {
+    {0, 0, -1},
+    {0, 0, 1},
+    {-1, 0, 0},
+    {1, 0, 0},
+    {0, -1, 0},
+    {0, 1, 0},
+};
+
+// Two triangles per quad, split along the 0-2 or the 1-3 diagonal
+const int QUAD_ORDER[6] = {0, 1, 2, 2, 3, 0};
+const int FLIPPED_QUAD_ORDER[6] = {1, 2, 3, 3, 0, 1};
+
+// Classic 3-neighbour corner occlusion: 3 = open, 0 = fully enclosed
+int vertexAO(bool side1, bool side2, bool corner) {
+    if (side1 && side2)
+        return 0;
+    return 3 - (side1 + side2 + corner);
 }
 
-void Chunk::Render(Shader& shader) {
-    if (m_VertexCount == 0)
-        return;
+void addFace(std::vector<ChunkVertex>& vertices,
+             const ChunkNeighbourhood& blocks,
+             glm::ivec3 p,
+             int face,
+             BlockType blockType,
+             MeshMode mode) {
+    int ao[4] = {3, 3, 3, 3};
+
+    // Flat shading takes the light of the cell the face looks into
+    glm::ivec3 front = p + FACE_NORMALS[face];
+    uint8_t faceLight = blocks.GetLight(front.x, front.y, front.z);
+    int sky[4], block[4];
+    for (int c = 0; c < 4; c++) {
+        sky[c] = faceLight >> 4;
+        block[c] = faceLight & 0x0F;
+    }
+
+    if (mode == MeshMode::AmbientOcclusion) {
+        glm::ivec3 n = FACE_NORMALS[face];
+        int axis = n.x != 0 ? 0 : (n.y != 0 ? 1 : 2);
+        int t1 = (axis + 1) % 3;
+        int t2 = (axis + 2) % 3;
+
+        // Occluders live in the layer of cells the face looks into
+        for (int c = 0; c < 4; c++) {
+            glm::ivec3 s1(0), s2(0);
+            s1[t1] = FACE_CORNERS[face][c][t1] > 0.0f ? 1 : -1;
+            s2[t2] = FACE_CORNERS[face][c][t2] > 0.0f ? 1 : -1;
+
+            glm::ivec3 a = front + s1;
+            glm::ivec3 b = front + s2;
+            glm::ivec3 d = front + s1 + s2;
+            bool solidA = blocks.IsSolid(a.x, a.y, a.z);
+            bool solidB = blocks.IsSolid(b.x, b.y, b.z);
+            bool solidD = blocks.IsSolid(d.x, d.y, d.z);
+            ao[c] = vertexAO(solidA, solidB, solidD);
+
+            // Smooth light: average the open cells around the corner, the
+            // same ones that decide the occlusion
+            int skySum = sky[c], blockSum = block[c], count = 1;
+            auto accumulate = [&](glm::ivec3 cell) {
+                uint8_t light = blocks.GetLight(cell.x, cell.y, cell.z);
+                skySum += light >> 4;
+                blockSum += light & 0x0F;
+                count++;
+            };
+            if (!solidA)
+                accumulate(a);
+            if (!solidB)
+                accumulate(b);
+            if (!solidD && !(solidA && solidB))
+                accumulate(d);
+            sky[c] = skySum / count;
+            block[c] = blockSum / count;
+        }
+    }
+
+    // Split along the brighter diagonal so the AO gradient looks the same
+    // whichever way the quad is oriented
+    const int* order =
+        (ao[0] + ao[2] < ao[1] + ao[3]) ? FLIPPED_QUAD_ORDER : QUAD_ORDER;
+
+    // Material lookup happens in the shader from the block type and face
+    uint32_t data = (uint32_t)blockType | ((uint32_t)face << 8);
+
+    for (int i = 0; i < 6; i++) {
+        int c = order[i];
+        const float* corner = FACE_CORNERS[face][c];
+
+        ChunkVertex v;
+        v.x = corner[0] + p.x;
+        v.y = corner[1] + p.y;
+        v.z = corner[2] + p.z;
+        v.u = corner[3];
+        v.v = corner[4];
+        v.data = data | ((uint32_t)ao[c] << 11) | ((uint32_t)sky[c] << 13) |
+                 ((uint32_t)block[c] << 17);
+        vertices.push_back(v);
+    }
+}
 
-    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(m_WorldPos));
-    shader.SetMat4("u_Model", model);
+} // namespace
+
+void Chunk::BuildMesh(const ChunkNeighbourhood& blocks,
+                      MeshMode mode,
+                      ChunkMeshData& out) {
+    ORIX_PROFILE_ZONE("Chunk::BuildMesh");
+
+    for (int s = 0; s < CHUNK_SECTION_COUNT; s++) {
+        if (!(out.sectionMask & (1u << s)))
+            continue;
+
+        std::vector<ChunkVertex>& vertices = out.sections[s];
+        vertices.clear();
+
+        int yBegin = s * CHUNK_SECTION_HEIGHT;
+        int yEnd = yBegin + CHUNK_SECTION_HEIGHT;
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            for (int y = yBegin; y < yEnd; y++) {
+                for (int z = 0; z < CHUNK_SIZE; z++) {
+                    BlockType blockType = blocks.Get(x, y, z);
+                    if (blockType == BlockType::Air)
+                        continue;
+
+                    glm::ivec3 pos(x, y, z);
+
+                    // Face culling, including against neighbouring chunks
+                    for (int face = 0; face < 6; face++) {
+                        glm::ivec3 n = pos + FACE_NORMALS[face];
+                        if (!blocks.IsSolid(n.x, n.y, n.z))
+                            addFace(
+                                vertices, blocks, pos, face, blockType, mode);
+                    }
+                }
+            }
+        }
+    }
 
-    glBindVertexArray(m_VAO);
-    glDrawArrays(GL_TRIANGLES, 0, m_VertexCount);
+    if (out.skirtDepth > 0 && (out.sectionMask & 1u))
+        BuildSkirts(blocks, out.skirtDepth, out.sections[0]);
 }
 
-// Helper function to keep code clean
-void Chunk::addFace(std::vector<float>& vertices,
-                    glm::vec3 p,
-                    int face,
-                    float blockType) {
-    // clang-format off
-    // Face data: 6 vertices per face, 5 floats per vertex (Pos X,Y,Z, U,V)
-    // Each face is 2 triangles = 6 vertices
-    const float faceData[6][30] = {
-        // Back face (face 0)
-        {-0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
-          0.5f, -0.5f, -0.5f,  1.0f, 0.0f,
-          0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-          0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-         -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
-         -0.5f, -0.5f, -0.5f,  0.0f, 0.0f},
-
-        // Front face (face 1)
-        {-0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-          0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-          0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
-          0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
-         -0.5f,  0.5f,  0.5f,  0.0f, 1.0f,
-         -0.5f, -0.5f,  0.5f,  0.0f, 0.0f},
-
-        // Left face (face 2)
-        {-0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-         -0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-         -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-         -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-         -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-         -0.5f,  0.5f,  0.5f,  1.0f, 0.0f},
-
-        // Right face (face 3)
-        { 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-          0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-          0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-          0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-          0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-          0.5f,  0.5f,  0.5f,  1.0f, 0.0f},
-
-        // Bottom face (face 4)
-        {-0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-          0.5f, -0.5f, -0.5f,  1.0f, 1.0f,
-          0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-          0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-         -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-         -0.5f, -0.5f, -0.5f,  0.0f, 1.0f},
-
-        // Top face (face 5)
-        {-0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
-          0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-          0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-          0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-         -0.5f,  0.5f,  0.5f,  0.0f, 0.0f,
-         -0.5f,  0.5f, -0.5f,  0.0f, 1.0f}
-    };
-    // clang-format on
-
-    // Add the face vertices, offset by the block position
-    for (int i = 0; i < 30; i += 5) {
-        vertices.push_back(faceData[face][i + 0] + p.x); // X position
-        vertices.push_back(faceData[face][i + 1] + p.y); // Y position
-        vertices.push_back(faceData[face][i + 2] + p.z); // Z position
-        vertices.push_back(faceData[face][i + 3]);       // U coord
-        vertices.push_back(faceData[face][i + 4]);       // V coord
-        vertices.push_back(blockType);                   // Block Type
+void Chunk::BuildSkirts(const ChunkNeighbourhood& blocks,
+                        int depth,
+                        std::vector<ChunkVertex>& out) {
+    // Only the four side faces get skirts
+    for (int face = 0; face < 4; face++) {
+        glm::ivec3 n = FACE_NORMALS[face];
+        int axis = n.x != 0 ? 0 : 2;
+        int along = axis == 0 ? 2 : 0;
+
+        for (int i = 0; i < CHUNK_SIZE; i++) {
+            glm::ivec3 p(0);
+            p[axis] = n[axis] < 0 ? 0 : CHUNK_SIZE - 1;
+            p[along] = i;
+
+            // Top of the column on the border
+            int top = CHUNK_SIZE - 1;
+            while (top >= 0 && !blocks.IsSolid(p.x, top, p.z))
+                top--;
+            if (top < 0)
+                continue;
+
+            // Cells facing open air already have their own side face, so
+            // the skirt starts below them
+            glm::ivec3 o = p + n;
+            int start = top;
+            while (start >= 0 && !blocks.IsSolid(o.x, start, o.z))
+                start--;
+            if (start < 0)
+                continue;
+
+            BlockType type = blocks.Get(p.x, top, p.z);
+            uint32_t data = (uint32_t)type | ((uint32_t)face << 8) |
+                            (3u << 11) | ((uint32_t)MAX_LIGHT_LEVEL << 13);
+
+            for (int k = 0; k < 6; k++) {
+                const float* corner = FACE_CORNERS[face][QUAD_ORDER[k]];
+
+                ChunkVertex v;
+                v.x = corner[0] + p.x;
+                v.y = corner[1] > 0.0f ? start + 0.5f : start + 0.5f - depth;
+                v.z = corner[2] + p.z;
+                v.u = corner[3];
+                v.v = corner[4];
+                v.data = data;
+                out.push_back(v);
+            }
+        }
     }
 }
 
@@ -206,6 +364,7 @@ void Chunk::SetBlock(int x, int y, int z, BlockType type) {
     if (x >= 0 && x < CHUNK_SIZE && y >= 0 && y < CHUNK_SIZE && z >= 0 &&
         z < CHUNK_SIZE) {
         m_Blocks[x][y][z] = Block(type);
+        MarkDirty(y);
     }
 }
 
@@ -0,0 +1,66 @@
+#include "game/ChunkPool.hpp"
+#include "core/MemoryTracker.hpp"
+
+ChunkPool::~ChunkPool() {
+    Clear();
+}
+
+ChunkHandle ChunkPool::Create(glm::ivec3 position) {
+    if (m_FreeHead == NO_SLOT)
+        addPage();
+
+    uint32_t index = m_FreeHead;
+    Slot& s = slot(index);
+    m_FreeHead = s.nextFree;
+
+    new (s.storage) Chunk(position);
+    s.alive = true;
+    m_Count++;
+    MemoryTracker::Add(MemoryCategory::ChunkVoxels, sizeof(Chunk));
+    return ChunkHandle{index, s.generation};
+}
+
+void ChunkPool::Destroy(ChunkHandle handle) {
+    if (!Get(handle))
+        return;
+
+    Slot& s = slot(handle.index);
+    s.Get()->~Chunk();
+    s.alive = false;
+
+    // Outstanding handles to this slot go stale
+    s.generation++;
+    s.nextFree = m_FreeHead;
+    m_FreeHead = handle.index;
+    m_Count--;
+    MemoryTracker::Remove(MemoryCategory::ChunkVoxels, sizeof(Chunk));
+}
+
+void ChunkPool::Clear() {
+    for (uint32_t i = 0; i < (uint32_t)GetCapacity(); i++) {
+        Slot& s = slot(i);
+        if (s.alive)
+            Destroy(ChunkHandle{i, s.generation});
+    }
+}
+
+Chunk* ChunkPool::Get(ChunkHandle handle) const {
+    if (handle.index >= (uint32_t)GetCapacity())
+        return nullptr;
+
+    Slot& s = slot(handle.index);
+    if (!s.alive || s.generation != handle.generation)
+        return nullptr;
+    return s.Get();
+}
+
+void ChunkPool::addPage() {
+    uint32_t first = (uint32_t)GetCapacity();
+    m_Pages.push_back(std::make_unique<Slot[]>(CHUNKS_PER_PAGE));
+
+    // Lowest index first off the free list, so chunks fill pages in order
+    for (uint32_t i = CHUNKS_PER_PAGE; i-- > 0;) {
+        m_Pages.back()[i].nextFree = m_FreeHead;
+        m_FreeHead = first + i;
+    }
+}
@@ -0,0 +1,331 @@
+#include "game/Lighting.hpp"
+#include "core/JobSystem.hpp"
+#include "game/Chunk.hpp"
+#include "game/World.hpp"
+#include <functional>
+#include <map>
+
+namespace {
+
+const glm::ivec3 NEIGHBOURS[6] = {
+    {0, 0, -1},
+    {0, 0, 1},
+    {-1, 0, 0},
+    {1, 0, 0},
+    {0, -1, 0},
+    {0, 1, 0},
+};
+const int DOWN = 4;
+
+int channelIndex(LightChannel channel) {
+    return (int)channel;
+}
+
+int unpack(uint8_t light, LightChannel channel) {
+    return channel == LightChannel::Sky ? (light >> 4) : (light & 0x0F);
+}
+
+uint8_t pack(uint8_t light, LightChannel channel, int level) {
+    if (channel == LightChannel::Sky)
+        return (uint8_t)((light & 0x0F) | (level << 4));
+    return (uint8_t)((light & 0xF0) | level);
+}
+
+// Sky light at full strength travels straight down without fading
+int spreadLevel(LightChannel channel, int direction, int level) {
+    if (channel == LightChannel::Sky && direction == DOWN &&
+        level == MAX_LIGHT_LEVEL)
+        return MAX_LIGHT_LEVEL;
+    return level - 1;
+}
+
+} // namespace
+
+LightEngine::LightEngine(World& world) : m_World(world) {}
+
+bool LightEngine::getLight(glm::ivec3 pos, LightChannel channel, int& level) {
+    Chunk* chunk = m_World.GetChunk(World::ToChunkOrigin(pos));
+    if (!chunk)
+        return false;
+
+    glm::ivec3 local = pos - chunk->GetWorldPos();
+    level = unpack(chunk->GetLight(local.x, local.y, local.z), channel);
+    return true;
+}
+
+void LightEngine::setLight(glm::ivec3 pos, LightChannel channel, int level) {
+    glm::ivec3 origin = World::ToChunkOrigin(pos);
+    Chunk* chunk = m_World.GetChunk(origin);
+    if (!chunk)
+        return;
+
+    glm::ivec3 local = pos - origin;
+    uint8_t light = chunk->GetLight(local.x, local.y, local.z);
+    chunk->SetLight(local.x, local.y, local.z, pack(light, channel, level));
+    m_World.MarkDirtyAt(pos);
+}
+
+void LightEngine::SeedChunk(Chunk& chunk) {
+    SeedChunks({&chunk});
+}
+
+void LightEngine::SeedChunks(const std::vector<Chunk*>& chunks) {
+    // A column only looks at the chunk above it, so everything in one
+    // layer can be seeded at once as long as the layers go top down
+    std::map<int, std::vector<Chunk*>, std::greater<int>> layers;
+    for (Chunk* chunk : chunks) {
+        layers[chunk->GetWorldPos().y].push_back(chunk);
+    }
+
+    for (auto& [y, layer] : layers) {
+        std::vector<SeedList> seeds(layer.size());
+        JobSystem::ParallelFor(
+            (int)layer.size(), 1, [&](int begin, int end) {
+                for (int i = begin; i < end; i++) {
+                    seedColumns(*layer[i], seeds[i]);
+                }
+            });
+
+        for (auto& seed : seeds) {
+            for (int c = 0; c < 2; c++) {
+                for (const LightNode& node : seed[c])
+                    m_AddQueue[c].push(node);
+            }
+        }
+    }
+
+    for (Chunk* chunk : chunks) {
+        seedFromBorder(*chunk);
+    }
+}
+
+void LightEngine::seedColumns(Chunk& chunk, SeedList& seeds) {
+    glm::ivec3 origin = chunk.GetWorldPos();
+    Chunk* above = m_World.GetChunk(origin + glm::ivec3(0, CHUNK_SIZE, 0));
+
+    // Writes stay inside this chunk, which is new and fully dirty anyway,
+    // so this is safe to run next to other chunks of the same layer
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        for (int z = 0; z < CHUNK_SIZE; z++) {
+            // Columns are open to the sky unless a loaded chunk above has
+            // already cut them off
+            bool open = true;
+            if (above)
+                open = unpack(above->GetLight(x, 0, z), LightChannel::Sky) ==
+                       MAX_LIGHT_LEVEL;
+
+            for (int y = CHUNK_SIZE - 1; y >= 0; y--) {
+                glm::ivec3 pos = origin + glm::ivec3(x, y, z);
+                BlockType type = chunk.GetBlock(x, y, z).type;
+                uint8_t light = chunk.GetLight(x, y, z);
+
+                if (IsOpaque(type))
+                    open = false;
+                if (open) {
+                    light = pack(light, LightChannel::Sky, MAX_LIGHT_LEVEL);
+                    seeds[channelIndex(LightChannel::Sky)].push_back(
+                        {pos, MAX_LIGHT_LEVEL});
+                }
+
+                int emission = GetLightEmission(type);
+                if (emission > 0) {
+                    light = pack(light, LightChannel::Block, emission);
+                    seeds[channelIndex(LightChannel::Block)].push_back(
+                        {pos, emission});
+                }
+
+                chunk.SetLight(x, y, z, light);
+            }
+        }
+    }
+}
+
+void LightEngine::seedFromBorder(Chunk& chunk) {
+    glm::ivec3 origin = chunk.GetWorldPos();
+
+    // Re-flood from lit cells just outside each face of the chunk
+    for (int i = 0; i < 6; i++) {
+        glm::ivec3 n = NEIGHBOURS[i];
+        if (!m_World.GetChunk(origin + n * CHUNK_SIZE))
+            continue;
+
+        int axis = n.x != 0 ? 0 : (n.y != 0 ? 1 : 2);
+        int t1 = (axis + 1) % 3;
+        int t2 = (axis + 2) % 3;
+
+        for (int a = 0; a < CHUNK_SIZE; a++) {
+            for (int b = 0; b < CHUNK_SIZE; b++) {
+                glm::ivec3 local(0);
+                local[axis] = n[axis] < 0 ? -1 : CHUNK_SIZE;
+                local[t1] = a;
+                local[t2] = b;
+                glm::ivec3 pos = origin + local;
+
+                for (int c = 0; c < 2; c++) {
+                    int level;
+                    if (getLight(pos, (LightChannel)c, level) && level > 1)
+                        m_AddQueue[c].push({pos, level});
+                }
+            }
+        }
+    }
+}
+
+void LightEngine::OnChunkLoaded(Chunk& chunk) {
+    glm::ivec3 origin = chunk.GetWorldPos();
+    Chunk* above = m_World.GetChunk(origin + glm::ivec3(0, CHUNK_SIZE, 0));
+    Chunk* below = m_World.GetChunk(origin - glm::ivec3(0, CHUNK_SIZE, 0));
+
+    if (below) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            for (int z = 0; z < CHUNK_SIZE; z++) {
+                bool open = !above || unpack(above->GetLight(x, 0, z),
+                                             LightChannel::Sky) ==
+                                          MAX_LIGHT_LEVEL;
+                for (int y = 0; y < CHUNK_SIZE && open; y++)
+                    open = !IsOpaque(chunk.GetBlock(x, y, z).type);
+                if (!open)
+                    removeLight(origin + glm::ivec3(x, -1, z),
+                                LightChannel::Sky);
+            }
+        }
+
+        // Before this chunk has light of its own for the removal to eat
+        Propagate();
+    }
+
+    SeedChunk(chunk);
+}
+
+void LightEngine::OnChunkUnloading(Chunk& chunk) {
+    glm::ivec3 origin = chunk.GetWorldPos();
+    for (int x = 0; x < CHUNK_SIZE; x++) {
+        for (int y = 0; y < CHUNK_SIZE; y++) {
+            // Inside the x and y faces only the two z faces are border
+            bool edge = x == 0 || x == CHUNK_SIZE - 1 || y == 0 ||
+                        y == CHUNK_SIZE - 1;
+            for (int z = 0; z < CHUNK_SIZE; z += edge ? 1 : CHUNK_SIZE - 1) {
+                uint8_t light = chunk.GetLight(x, y, z);
+                for (int c = 0; c < 2; c++) {
+                    int level = unpack(light, (LightChannel)c);
+                    if (level > 0)
+                        m_RemoveQueue[c].push(
+                            {origin + glm::ivec3(x, y, z), level});
+                }
+            }
+        }
+    }
+}
+
+void LightEngine::OnBlockChanged(glm::ivec3 pos,
+                                 BlockType oldType,
+                                 BlockType newType) {
+    // Block light: drop whatever lit this cell and refill from the new state
+    if (GetLightEmission(oldType) > 0 || IsOpaque(newType))
+        removeLight(pos, LightChannel::Block);
+
+    int emission = GetLightEmission(newType);
+    if (emission > 0) {
+        setLight(pos, LightChannel::Block, emission);
+        m_AddQueue[channelIndex(LightChannel::Block)].push({pos, emission});
+    }
+
+    if (IsOpaque(newType)) {
+        removeLight(pos, LightChannel::Sky);
+    } else if (IsOpaque(oldType)) {
+        // Opened a hole: let the neighbours flood back into it
+        for (int i = 0; i < 6; i++) {
+            glm::ivec3 np = pos + NEIGHBOURS[i];
+            for (int c = 0; c < 2; c++) {
+                int level;
+                if (getLight(np, (LightChannel)c, level) && level > 0)
+                    m_AddQueue[c].push({np, level});
+            }
+        }
+
+        // Nothing loaded above means the column is open to the sky
+        int above;
+        if (!getLight(pos + glm::ivec3(0, 1, 0), LightChannel::Sky, above)) {
+            setLight(pos, LightChannel::Sky, MAX_LIGHT_LEVEL);
+            m_AddQueue[channelIndex(LightChannel::Sky)].push(
+                {pos, MAX_LIGHT_LEVEL});
+        }
+    }
+}
+
+void LightEngine::removeLight(glm::ivec3 pos, LightChannel channel) {
+    int level;
+    if (!getLight(pos, channel, level) || level == 0)
+        return;
+
+    setLight(pos, channel, 0);
+    m_RemoveQueue[channelIndex(channel)].push({pos, level});
+}
+
+void LightEngine::Propagate() {
+    for (int c = 0; c < 2; c++) {
+        propagateRemoval((LightChannel)c);
+        propagateAdd((LightChannel)c);
+    }
+}
+
+void LightEngine::propagateRemoval(LightChannel channel) {
+    auto& removeQueue = m_RemoveQueue[channelIndex(channel)];
+    auto& addQueue = m_AddQueue[channelIndex(channel)];
+
+    while (!removeQueue.empty()) {
+        LightNode node = removeQueue.front();
+        removeQueue.pop();
+
+        for (int i = 0; i < 6; i++) {
+            glm::ivec3 np = node.pos + NEIGHBOURS[i];
+            int level;
+            if (!getLight(np, channel, level) || level == 0)
+                continue;
+
+            // Anything dimmer than us (or a full-strength sky column below
+            // us) was lit through this cell, so it goes dark too. Brighter
+            // cells have another source and refill the gap afterwards.
+            if (level == spreadLevel(channel, i, node.level) ||
+                level < node.level) {
+                setLight(np, channel, 0);
+                removeQueue.push({np, level});
+            } else {
+                addQueue.push({np, level});
+            }
+        }
+    }
+}
+
+void LightEngine::propagateAdd(LightChannel channel) {
+    auto& addQueue = m_AddQueue[channelIndex(channel)];
+
+    while (!addQueue.empty()) {
+        LightNode node = addQueue.front();
+        addQueue.pop();
+
+        // The cell may have been darkened again after it was queued
+        int level;
+        if (!getLight(node.pos, channel, level) || level <= 1)
+            continue;
+
+        for (int i = 0; i < 6; i++) {
+            glm::ivec3 np = node.pos + NEIGHBOURS[i];
+            Chunk* chunk = m_World.GetChunk(World::ToChunkOrigin(np));
+            if (!chunk)
+                continue;
+
+            glm::ivec3 local = np - chunk->GetWorldPos();
+            if (IsOpaque(chunk->GetBlock(local.x, local.y, local.z).type))
+                continue;
+
+            int spread = spreadLevel(channel, i, level);
+            int current =
+                unpack(chunk->GetLight(local.x, local.y, local.z), channel);
+            if (current < spread) {
+                setLight(np, channel, spread);
+                addQueue.push({np, spread});
+            }
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#include "game/MeshQueue.hpp"
+#include "core/MemoryTracker.hpp"
+#include <algorithm>
+
+namespace {
+int64_t sectionBytes(const ChunkMeshData& mesh) {
+    int64_t total = 0;
+    for (const auto& section : mesh.sections)
+        total += section.capacity() * sizeof(ChunkVertex);
+    return total;
+}
+} // namespace
+
+MeshQueue::~MeshQueue() {
+    Flush();
+
+    for (auto& job : m_Jobs) {
+        MemoryTracker::Remove(MemoryCategory::CpuMesh,
+                              sizeof(MeshJob) + job->trackedBytes);
+    }
+}
+
+MeshJob* MeshQueue::Acquire() {
+    if (m_FreeJobs.empty()) {
+        m_Jobs.push_back(std::make_unique<MeshJob>());
+        m_FreeJobs.push_back(m_Jobs.back().get());
+        MemoryTracker::Add(MemoryCategory::CpuMesh, sizeof(MeshJob));
+    }
+
+    MeshJob* job = m_FreeJobs.back();
+    m_FreeJobs.pop_back();
+
+    // Sections keep whatever a previous use left; BuildMesh clears the
+    // ones it rebuilds
+    job->mesh.origin = glm::ivec3(0);
+    job->mesh.lodLevel = 0;
+    job->mesh.skirtDepth = 0;
+    job->mesh.sectionMask = 0;
+    return job;
+}
+
+void MeshQueue::Submit(MeshJob* job) {
+    // Two pointers fit std::function's inline storage, so queueing doesn't
+    // allocate either
+    JobSystem::Run(
+        [this, job] {
+            Chunk::BuildMesh(job->blocks, job->mode, job->mesh);
+
+            std::lock_guard<std::mutex> lock(m_ResultMutex);
+            m_Results.push_back(job);
+        },
+        &m_Pending);
+}
+
+void MeshQueue::Recycle(MeshJob* job) {
+    // Building and ApplyMesh's swap both change what the job holds
+    int64_t bytes = sectionBytes(job->mesh);
+    MemoryTracker::Add(MemoryCategory::CpuMesh, bytes - job->trackedBytes);
+    job->trackedBytes = bytes;
+
+    m_FreeJobs.push_back(job);
+}
+
+void MeshQueue::CollectResults(std::vector<MeshJob*>& out, size_t maxResults) {
+    std::lock_guard<std::mutex> lock(m_ResultMutex);
+    if (out.size() >= maxResults)
+        return;
+    size_t count = std::min(m_Results.size(), maxResults - out.size());
+    out.insert(out.end(), m_Results.begin(), m_Results.begin() + count);
+    m_Results.erase(m_Results.begin(), m_Results.begin() + count);
+}
+
+void MeshQueue::Flush() {
+    JobSystem::Wait(m_Pending);
+}
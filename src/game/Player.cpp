@@ -1,23 +1,38 @@
 #include "game/Player.hpp"
+#include <cmath>
 
 Player::Player() {
     Position = glm::vec3(8.0f, 30.0f, 8.0f);
+    PreviousPosition = Position;
 }
 
-void Player::Update(float deltaTime, World& world) {
-    HandleMovement(deltaTime, world);
-    m_Camera.Position = Position + glm::vec3(0.0f, Height, 0.0f);
+void Player::Update(float deltaTime, World& world, const PlayerInput& input) {
+    PreviousPosition = Position;
+    HandleMovement(deltaTime, world, input);
 }
 
-void Player::UpdateCameraRotation(float deltaTime) {
-    m_Camera.Update(deltaTime);
+void Player::Interpolate(float alpha) {
+    glm::vec3 renderPos = glm::mix(PreviousPosition, Position, alpha);
+    m_Camera.Position = renderPos + glm::vec3(0.0f, Height, 0.0f);
+}
+
+void Player::UpdateCameraRotation(glm::vec2 mouseDelta) {
+    m_Camera.Update(mouseDelta);
 
     // Sync player's yaw and pitch with camera's rotation
     Yaw = m_Camera.Yaw;
     Pitch = m_Camera.Pitch;
 }
 
-void Player::HandleMovement(float deltaTime, World& world) {
+void Player::SetRotation(float yaw, float pitch) {
+    m_Camera.SetRotation(yaw, pitch);
+    Yaw = yaw;
+    Pitch = pitch;
+}
+
+void Player::HandleMovement(float deltaTime,
+                            World& world,
+                            const PlayerInput& input) {
     // 1. Apply Gravity
     if (!IsGrounded) {
         Velocity.y += GRAVITY * deltaTime;
@@ -25,20 +40,19 @@ void Player::HandleMovement(float deltaTime, World& world) {
         Velocity.y = -0.1f; // Small downward force to stay glued to slopes
     }
 
-    // 2. Horizontal Input
-    glm::vec3 front =
-        glm::normalize(glm::vec3(m_Camera.Front.x, 0, m_Camera.Front.z));
-    glm::vec3 right =
-        glm::normalize(glm::vec3(m_Camera.Right.x, 0, m_Camera.Right.z));
+    // 2. Horizontal Input (same flattened basis as the camera's)
+    float yaw = glm::radians(Yaw);
+    glm::vec3 front(cos(yaw), 0.0f, sin(yaw));
+    glm::vec3 right(-sin(yaw), 0.0f, cos(yaw));
 
     glm::vec3 moveDir(0.0f);
-    if (Input::IsKeyDown(SDL_SCANCODE_W))
+    if (input.forward)
         moveDir += front;
-    if (Input::IsKeyDown(SDL_SCANCODE_S))
+    if (input.backward)
         moveDir -= front;
-    if (Input::IsKeyDown(SDL_SCANCODE_A))
+    if (input.left)
         moveDir -= right;
-    if (Input::IsKeyDown(SDL_SCANCODE_D))
+    if (input.right)
         moveDir += right;
 
     if (glm::length(moveDir) > 0)
@@ -49,7 +63,7 @@ void Player::HandleMovement(float deltaTime, World& world) {
     Velocity.z = moveDir.z * Speed;
 
     // 3. Jumping
-    if (IsGrounded && Input::IsKeyDown(SDL_SCANCODE_SPACE)) {
+    if (IsGrounded && input.jump) {
         Velocity.y = JumpForce;
         IsGrounded = false;
     }
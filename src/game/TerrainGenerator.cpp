@@ -0,0 +1,28 @@
+#include "game/TerrainGenerator.hpp"
+#include "core/MemoryTracker.hpp"
+
+TerrainGenerator::TerrainGenerator(int seed) {
+    m_Noise.SetSeed(seed);
+    m_Noise.SetNoiseType(FastNoiseLite::NoiseType_Perlin);
+    m_Noise.SetFrequency(0.05f);
+    MemoryTracker::Add(MemoryCategory::Noise, sizeof(m_Noise));
+}
+
+TerrainGenerator::~TerrainGenerator() {
+    MemoryTracker::Remove(MemoryCategory::Noise, sizeof(m_Noise));
+}
+
+int TerrainGenerator::GetHeight(int worldX, int worldZ) const {
+    float noiseValue = m_Noise.GetNoise((float)worldX, (float)worldZ);
+    return (int)((noiseValue + 1.0f) * 8.0f);
+}
+
+BlockType TerrainGenerator::GetBlockInColumn(int y, int height) {
+    if (y < 0 || y >= height)
+        return BlockType::Air;
+    if (y == height - 1)
+        return BlockType::Grass; // Top block is grass
+    if (y >= height - 4)
+        return BlockType::Dirt; // Next 3 blocks down are dirt
+    return BlockType::Stone;    // Everything below is stone
+}
@@ -1,242 +1,291 @@
 #include "game/World.hpp"
-#include "platform/Steam.hpp"
-#include "renderer/Mesh.hpp"
-#include <glad/glad.h>
-#include <glm/gtc/matrix_transform.hpp>
+#include "core/Profiler.hpp"
+#include <cmath>
 
-World::World() {}
+World::World(int seed)
+    : m_Seed(seed), m_Terrain(seed), m_Lighting(*this) {}
 
-World::~World() {}
+World::~World() {
+    // In-flight jobs only hold snapshots, but they report back to the queue
+    m_MeshQueue.Flush();
+    m_ChunkPool.Clear();
+}
+
+namespace {
+// Cap remeshes landing per frame so a burst of edits can't cause an upload
+// spike in the renderer
+const size_t MAX_MESH_RESULTS_PER_FRAME = 8;
+} // namespace
 
 void World::Init() {
+    std::vector<glm::ivec3> positions;
     for (int x = 0; x < 4; x++) {
         for (int z = 0; z < 4; z++) {
-            glm::ivec3 chunkPos(x * CHUNK_SIZE, 0, z * CHUNK_SIZE);
-            Chunk* newChunk = new Chunk(chunkPos);
-            newChunk->GenerateMesh();
-            m_Chunks[chunkPos] = newChunk;
+            positions.push_back(glm::ivec3(x * CHUNK_SIZE, 0, z * CHUNK_SIZE));
         }
     }
 
-    InitPlayerCube();
+    // Slots come from the pool up front; terrain generation only reads the
+    // generator, so the chunks then fill in parallel
+    std::vector<Chunk*> chunks;
+    for (glm::ivec3 pos : positions) {
+        ChunkHandle handle = m_ChunkPool.Create(pos);
+        m_Chunks[pos] = handle;
+        chunks.push_back(m_ChunkPool.Get(handle));
+    }
+    JobSystem::ParallelFor((int)chunks.size(), 1, [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            chunks[i]->Generate(m_Terrain);
+        }
+    });
+
+    // Light the whole area in one flood fill once every chunk exists
+    m_Lighting.SeedChunks(chunks);
+    m_Lighting.Propagate();
+
+    // Mesh once every chunk exists so borders can see their neighbours.
+    // Gathering and meshing only read the world.
+    std::vector<ChunkMeshData> meshes(chunks.size());
+    JobSystem::ParallelFor((int)chunks.size(), 1, [&](int begin, int end) {
+        ChunkNeighbourhood blocks;
+        for (int i = begin; i < end; i++) {
+            chunks[i]->GatherNeighbourhood(*this, blocks);
+            meshes[i].origin = chunks[i]->GetWorldPos();
+            meshes[i].sectionMask = ALL_CHUNK_SECTIONS;
+            Chunk::BuildMesh(blocks, Chunk::s_MeshMode, meshes[i]);
+        }
+    });
+    for (size_t i = 0; i < chunks.size(); i++) {
+        chunks[i]->TakeDirtySections();
+        chunks[i]->ApplyMesh(meshes[i]);
+    }
 }
 
 void World::Update(float deltaTime) {
-    // Future: Handle block placing/breaking or day/night cycle
+    ORIX_PROFILE_ZONE("World::Update");
+
+    applyFinishedMeshes();
+    scheduleDirtyMeshes();
 }
 
-void World::Render(Shader& shader,
-                   const Camera& camera,
-                   int width,
-                   int height) {
-    shader.Use();
-    glm::mat4 view = camera.GetViewMatrix();
-    glm::mat4 projection =
-        camera.GetProjectionMatrix((float)width, (float)height);
-
-    // We send View and Projection once. Model is sent per chunk inside
-    // Chunk::Render.
-    shader.SetMat4("u_VP", projection * view);
-
-    for (auto const& [pos, chunk] : m_Chunks) {
-        chunk->Render(shader);
-    }
+void World::applyFinishedMeshes() {
+    m_FinishedMeshes.clear();
+    m_MeshQueue.CollectResults(m_FinishedMeshes, MAX_MESH_RESULTS_PER_FRAME);
 
-    // Bind the player cube VAO for rendering remote players
-    glBindVertexArray(m_PlayerCubeVAO);
-
-    // Render remote players
-    for (auto const& [id, data] : Steam::RemotePlayers) {
-        // Render body (rectangular box that rotates with yaw)
-        glm::mat4 bodyModel = glm::mat4(1.0f);
-        bodyModel = glm::translate(bodyModel, data.currentPos);
-        bodyModel = glm::translate(
-            bodyModel,
-            glm::vec3(0.0f, 0.6f, 0.0f)); // Lift body so bottom is at feet
-        bodyModel = glm::rotate(
-            bodyModel, glm::radians(-(data.yaw - 90.0f)), glm::vec3(0, 1, 0));
-        bodyModel = glm::scale(bodyModel, glm::vec3(0.6f, 1.2f, 0.4f));
-
-        shader.SetMat4("u_Model", bodyModel);
-        shader.SetVec3("u_Color", glm::vec3(0.2f, 0.4f, 1.0f));
-        glDrawArrays(GL_TRIANGLES, 0, 36);
-
-        // Render head (cube positioned above body, rotates with yaw and tilts
-        // with pitch)
-        glm::mat4 headModel = glm::mat4(1.0f);
-        headModel = glm::translate(headModel, data.currentPos);
-        headModel = glm::translate(
-            headModel,
-            glm::vec3(
-                0.0f,
-                1.6f,
-                0.0f)); // Position head above body (body height 1.2 + 0.4)
-        headModel = glm::rotate(headModel,
-                                glm::radians(-(data.yaw - 90.0f)),
-                                glm::vec3(0, 1, 0)); // Rotate with body
-        headModel = glm::rotate(headModel,
-                                glm::radians(-data.pitch),
-                                glm::vec3(1, 0, 0)); // Tilt up/down
-        headModel = glm::scale(headModel, glm::vec3(0.4f, 0.4f, 0.4f));
-
-        shader.SetMat4("u_Model", headModel);
-        shader.SetVec3("u_Color", glm::vec3(1.0f, 0.8f, 0.6f));
-        glDrawArrays(GL_TRIANGLES, 0, 36);
+    int chunksMeshed = 0;
+    for (MeshJob* job : m_FinishedMeshes) {
+        // ApplyMesh swaps the chunk's old sections into the job, so the
+        // next job built with it reuses their memory. A chunk unloaded
+        // meanwhile, or reloaded at the same origin, has a new handle.
+        if (Chunk* chunk = m_ChunkPool.Get(job->chunk)) {
+            chunk->ApplyMesh(job->mesh);
+            chunk->SetMeshPending(false);
+            chunksMeshed++;
+        }
+        m_MeshQueue.Recycle(job);
     }
+    ORIX_PROFILE_COUNTER("Chunks Meshed", chunksMeshed);
+}
+
+void World::scheduleDirtyMeshes() {
+    // All edits made this frame are already folded into the dirty masks, so
+    // each chunk gets at most one job. Chunks with a job still in flight
+    // stay dirty and are picked up once it lands.
+    m_ChunkPool.ForEach([&](ChunkHandle handle, Chunk& chunk) {
+        if (!chunk.IsDirty() || chunk.IsMeshPending())
+            return;
+
+        MeshJob* job = m_MeshQueue.Acquire();
+        job->chunk = handle;
+        job->mode = Chunk::s_MeshMode;
+        job->mesh.origin = chunk.GetWorldPos();
+        job->mesh.sectionMask = chunk.TakeDirtySections();
+        chunk.GatherNeighbourhood(*this, job->blocks);
 
-    // Unbind VAO
-    glBindVertexArray(0);
+        chunk.SetMeshPending(true);
+        m_MeshQueue.Submit(job);
+    });
 }
 
 Block World::GetBlockAt(int x, int y, int z) {
-    // 1. Find which chunk this coordinate belongs to
-    // (Divide by 16 and floor)
-    glm::ivec3 chunkCoord((x >= 0) ? x / 16 : (x - 15) / 16,
-                          (y >= 0) ? y / 16 : (y - 15) / 16,
-                          (z >= 0) ? z / 16 : (z - 15) / 16);
+    glm::ivec3 chunkCoord = ToChunkOrigin(glm::ivec3(x, y, z));
 
-    // Scale back up to get the chunk's world origin
-    chunkCoord *= 16;
-
-    if (m_Chunks.find(chunkCoord) != m_Chunks.end()) {
-        // 2. Find local coordinates inside that chunk (0-15)
+    if (Chunk* chunk = GetChunk(chunkCoord)) {
+        // Find local coordinates inside that chunk (0-15)
         int lx = x - chunkCoord.x;
         int ly = y - chunkCoord.y;
         int lz = z - chunkCoord.z;
-        return m_Chunks[chunkCoord]->GetBlock(lx, ly, lz);
+        return chunk->GetBlock(lx, ly, lz);
     }
 
     return Block(BlockType::Air); // If chunk doesn't exist, it's air
 }
 
-void World::InitPlayerCube() {
-    // Simple cube vertices (position only, 36 vertices for 6 faces)
-    float vertices[] = {// Back face
-                        -0.5f,
-                        -0.5f,
-                        -0.5f,
-                        0.5f,
-                        -0.5f,
-                        -0.5f,
-                        0.5f,
-                        0.5f,
-                        -0.5f,
-                        0.5f,
-                        0.5f,
-                        -0.5f,
-                        -0.5f,
-                        0.5f,
-                        -0.5f,
-                        -0.5f,
-                        -0.5f,
-                        -0.5f,
-                        // Front face
-                        -0.5f,
-                        -0.5f,
-                        0.5f,
-                        0.5f,
-                        -0.5f,
-                        0.5f,
-                        0.5f,
-                        0.5f,
-                        0.5f,
-                        0.5f,
-                        0.5f,
-                        0.5f,
-                        -0.5f,
-                        0.5f,
-                        0.5f,
-                        -0.5f,
-                        -0.5f,
-                        0.5f,
-                        // Left face
-                        -0.5f,
-                        0.5f,
-                        0.5f,
-                        -0.5f,
-                        0.5f,
-                        -0.5f,
-                        -0.5f,
-                        -0.5f,
-                        -0.5f,
-                        -0.5f,
-                        -0.5f,
-                        -0.5f,
-                        -0.5f,
-                        -0.5f,
-                        0.5f,
-                        -0.5f,
-                        0.5f,
-                        0.5f,
-                        // Right face
-                        0.5f,
-                        0.5f,
-                        0.5f,
-                        0.5f,
-                        0.5f,
-                        -0.5f,
-                        0.5f,
-                        -0.5f,
-                        -0.5f,
-                        0.5f,
-                        -0.5f,
-                        -0.5f,
-                        0.5f,
-                        -0.5f,
-                        0.5f,
-                        0.5f,
-                        0.5f,
-                        0.5f,
-                        // Bottom face
-                        -0.5f,
-                        -0.5f,
-                        -0.5f,
-                        0.5f,
-                        -0.5f,
-                        -0.5f,
-                        0.5f,
-                        -0.5f,
-                        0.5f,
-                        0.5f,
-                        -0.5f,
-                        0.5f,
-                        -0.5f,
-                        -0.5f,
-                        0.5f,
-                        -0.5f,
-                        -0.5f,
-                        -0.5f,
-                        // Top face
-                        -0.5f,
-                        0.5f,
-                        -0.5f,
-                        0.5f,
-                        0.5f,
-                        -0.5f,
-                        0.5f,
-                        0.5f,
-                        0.5f,
-                        0.5f,
-                        0.5f,
-                        0.5f,
-                        -0.5f,
-                        0.5f,
-                        0.5f,
-                        -0.5f,
-                        0.5f,
-                        -0.5f};
-
-    glGenVertexArrays(1, &m_PlayerCubeVAO);
-    glGenBuffers(1, &m_PlayerCubeVBO);
-
-    glBindVertexArray(m_PlayerCubeVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_PlayerCubeVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    // Position attribute (location 0)
-    glVertexAttribPointer(
-        0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    glBindVertexArray(0);
-}
\ No newline at end of file
+void World::SetBlockAt(int x, int y, int z, BlockType type) {
+    glm::ivec3 pos(x, y, z);
+    glm::ivec3 origin = ToChunkOrigin(pos);
+    Chunk* chunk = GetChunk(origin);
+    if (!chunk)
+        return;
+
+    glm::ivec3 local = pos - origin;
+    BlockType oldType = chunk->GetBlock(local.x, local.y, local.z).type;
+    if (oldType == type)
+        return;
+
+    chunk->SetBlock(local.x, local.y, local.z, type);
+    MarkDirtyAt(pos);
+
+    // Only the cells whose light depends on this voxel are revisited
+    m_Lighting.OnBlockChanged(pos, oldType, type);
+    m_Lighting.Propagate();
+}
+
+void World::MarkDirtyAt(glm::ivec3 worldPos) {
+    glm::ivec3 origin = ToChunkOrigin(worldPos);
+    glm::ivec3 local = worldPos - origin;
+
+    // Culling, AO and smooth light read one block across chunk borders, so
+    // a voxel on the edge also dirties the neighbour(s) it touches
+    for (int dx = -1; dx <= 1; dx++) {
+        if ((dx == -1 && local.x != 0) || (dx == 1 && local.x != CHUNK_SIZE - 1))
+            continue;
+        for (int dy = -1; dy <= 1; dy++) {
+            if ((dy == -1 && local.y != 0) ||
+                (dy == 1 && local.y != CHUNK_SIZE - 1))
+                continue;
+            for (int dz = -1; dz <= 1; dz++) {
+                if ((dz == -1 && local.z != 0) ||
+                    (dz == 1 && local.z != CHUNK_SIZE - 1))
+                    continue;
+
+                glm::ivec3 offset(dx, dy, dz);
+                Chunk* chunk = GetChunk(origin + offset * CHUNK_SIZE);
+                if (chunk)
+                    chunk->MarkDirty(local.y - dy * CHUNK_SIZE);
+            }
+        }
+    }
+}
+
+bool World::Raycast(glm::vec3 origin,
+                    glm::vec3 direction,
+                    float maxDistance,
+                    glm::ivec3& hitBlock,
+                    glm::ivec3& hitNormal) {
+    // Amanatides & Woo voxel traversal
+    glm::ivec3 block((int)floor(origin.x),
+                     (int)floor(origin.y),
+                     (int)floor(origin.z));
+    glm::ivec3 step(0);
+    glm::vec3 tMax(INFINITY);
+    glm::vec3 tDelta(INFINITY);
+
+    for (int i = 0; i < 3; i++) {
+        if (direction[i] > 0.0f) {
+            step[i] = 1;
+            tDelta[i] = 1.0f / direction[i];
+            tMax[i] = (block[i] + 1.0f - origin[i]) * tDelta[i];
+        } else if (direction[i] < 0.0f) {
+            step[i] = -1;
+            tDelta[i] = -1.0f / direction[i];
+            tMax[i] = (origin[i] - block[i]) * tDelta[i];
+        }
+    }
+
+    glm::ivec3 normal(0);
+    float t = 0.0f;
+    while (t <= maxDistance) {
+        if (GetBlockAt(block.x, block.y, block.z).IsActive()) {
+            hitBlock = block;
+            hitNormal = normal;
+            return true;
+        }
+
+        // Advance along whichever axis reaches its next boundary first
+        int axis = 0;
+        if (tMax[1] < tMax[axis])
+            axis = 1;
+        if (tMax[2] < tMax[axis])
+            axis = 2;
+
+        t = tMax[axis];
+        tMax[axis] += tDelta[axis];
+        block[axis] += step[axis];
+        normal = glm::ivec3(0);
+        normal[axis] = -step[axis];
+    }
+
+    return false;
+}
+
+Chunk* World::GetChunk(glm::ivec3 chunkOrigin) {
+    auto it = m_Chunks.find(chunkOrigin);
+    return it != m_Chunks.end() ? m_ChunkPool.Get(it->second) : nullptr;
+}
+
+Chunk* World::LoadChunk(glm::ivec3 chunkOrigin) {
+    if (Chunk* chunk = GetChunk(chunkOrigin))
+        return chunk;
+
+    ChunkHandle handle = m_ChunkPool.Create(chunkOrigin);
+    m_Chunks[chunkOrigin] = handle;
+    Chunk* chunk = m_ChunkPool.Get(handle);
+    chunk->Generate(m_Terrain);
+
+    m_Lighting.OnChunkLoaded(*chunk);
+    m_Lighting.Propagate();
+
+    // New chunks start fully dirty; faces that were open against the gap
+    // are hidden now
+    markNeighboursDirty(chunkOrigin);
+    return chunk;
+}
+
+void World::UnloadChunk(glm::ivec3 chunkOrigin) {
+    auto it = m_Chunks.find(chunkOrigin);
+    if (it == m_Chunks.end())
+        return;
+
+    // A mesh job still in flight holds the old handle and is dropped when
+    // it lands
+    m_Lighting.OnChunkUnloading(*m_ChunkPool.Get(it->second));
+    m_ChunkPool.Destroy(it->second);
+    m_Chunks.erase(it);
+    m_Lighting.Propagate();
+
+    // Nothing shades the chunk below any more, so its columns see the sky
+    glm::ivec3 belowOrigin = chunkOrigin - glm::ivec3(0, CHUNK_SIZE, 0);
+    if (Chunk* below = GetChunk(belowOrigin)) {
+        m_Lighting.SeedChunk(*below);
+        m_Lighting.Propagate();
+    }
+
+    // Faces that were hidden against it are open air now
+    markNeighboursDirty(chunkOrigin);
+}
+
+void World::markNeighboursDirty(glm::ivec3 chunkOrigin) {
+    for (int dx = -1; dx <= 1; dx++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dz = -1; dz <= 1; dz++) {
+                glm::ivec3 offset(dx, dy, dz);
+                if (offset == glm::ivec3(0))
+                    continue;
+                if (Chunk* chunk = GetChunk(chunkOrigin + offset * CHUNK_SIZE))
+                    chunk->MarkAllDirty();
+            }
+        }
+    }
+}
+
+glm::ivec3 World::ToChunkOrigin(glm::ivec3 worldPos) {
+    // Divide by CHUNK_SIZE rounding toward negative infinity
+    auto floorDiv = [](int v) {
+        return (v >= 0) ? v / CHUNK_SIZE : (v - CHUNK_SIZE + 1) / CHUNK_SIZE;
+    };
+    return glm::ivec3(floorDiv(worldPos.x),
+                      floorDiv(worldPos.y),
+                      floorDiv(worldPos.z)) *
+           CHUNK_SIZE;
+}
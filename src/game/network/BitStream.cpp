@@ -0,0 +1,50 @@
+#include "game/network/BitStream.hpp"
+
+namespace {
+uint64_t lowBits(int bits) {
+    return ((uint64_t)1 << bits) - 1;
+}
+} // namespace
+
+BitWriter::BitWriter(std::vector<uint8_t>& buffer) : m_Buffer(buffer) {
+    m_Buffer.clear();
+}
+
+void BitWriter::Write(uint32_t value, int bits) {
+    // Never more than 7 bits are left over, so 32 more always fit
+    m_Scratch |= (value & lowBits(bits)) << m_ScratchBits;
+    m_ScratchBits += bits;
+    m_BitCount += bits;
+
+    while (m_ScratchBits >= 8) {
+        m_Buffer.push_back((uint8_t)m_Scratch);
+        m_Scratch >>= 8;
+        m_ScratchBits -= 8;
+    }
+}
+
+void BitWriter::Finish() {
+    if (m_ScratchBits > 0)
+        m_Buffer.push_back((uint8_t)m_Scratch);
+    m_Scratch = 0;
+    m_ScratchBits = 0;
+}
+
+BitReader::BitReader(const void* data, size_t size)
+    : m_Data((const uint8_t*)data), m_Size(size) {}
+
+uint32_t BitReader::Read(int bits) {
+    while (m_ScratchBits < bits) {
+        if (m_Offset >= m_Size) {
+            m_Overflowed = true;
+            return 0;
+        }
+        m_Scratch |= (uint64_t)m_Data[m_Offset++] << m_ScratchBits;
+        m_ScratchBits += 8;
+    }
+
+    uint32_t value = (uint32_t)(m_Scratch & lowBits(bits));
+    m_Scratch >>= bits;
+    m_ScratchBits -= bits;
+    return value;
+}
@@ -0,0 +1,110 @@
+#include "game/network/InputCommand.hpp"
+#include "game/Chunk.hpp"
+#include "game/Player.hpp"
+#include "game/network/NetworkPackets.hpp"
+#include "game/network/Snapshot.hpp"
+
+namespace {
+
+const uint8_t INPUT_BUTTON_FORWARD = 1 << 0;
+const uint8_t INPUT_BUTTON_BACKWARD = 1 << 1;
+const uint8_t INPUT_BUTTON_LEFT = 1 << 2;
+const uint8_t INPUT_BUTTON_RIGHT = 1 << 3;
+const uint8_t INPUT_BUTTON_JUMP = 1 << 4;
+const int INPUT_BUTTON_BITS = 5;
+
+const int SIMULATION_RATE_BITS = 10;
+static_assert(MAX_SIMULATION_RATE < (1 << SIMULATION_RATE_BITS));
+
+const int COMMAND_COUNT_BITS = 6;
+static_assert(MAX_SENT_COMMANDS < (1 << COMMAND_COUNT_BITS));
+static_assert(MAX_SENT_COMMANDS <= INPUT_HISTORY / 2);
+
+// Players who fall out of the world are dropped back in from this height
+const float RESPAWN_HEIGHT = 30.0f;
+
+} // namespace
+
+InputCommand InputCommand::Make(uint16_t sequence,
+                                const PlayerInput& input,
+                                float yaw,
+                                float pitch) {
+    InputCommand command;
+    command.sequence = sequence;
+    command.buttons = (input.forward ? INPUT_BUTTON_FORWARD : 0) |
+                      (input.backward ? INPUT_BUTTON_BACKWARD : 0) |
+                      (input.left ? INPUT_BUTTON_LEFT : 0) |
+                      (input.right ? INPUT_BUTTON_RIGHT : 0) |
+                      (input.jump ? INPUT_BUTTON_JUMP : 0);
+    command.yaw = QuantizeYaw(yaw);
+    command.pitch = QuantizePitch(pitch);
+    return command;
+}
+
+PlayerInput InputCommand::GetInput() const {
+    PlayerInput input;
+    input.forward = (buttons & INPUT_BUTTON_FORWARD) != 0;
+    input.backward = (buttons & INPUT_BUTTON_BACKWARD) != 0;
+    input.left = (buttons & INPUT_BUTTON_LEFT) != 0;
+    input.right = (buttons & INPUT_BUTTON_RIGHT) != 0;
+    input.jump = (buttons & INPUT_BUTTON_JUMP) != 0;
+    return input;
+}
+
+void SimulateCommand(Player& player,
+                     World& world,
+                     const InputCommand& command,
+                     float step) {
+    player.Yaw = DequantizeYaw(command.yaw);
+    player.Pitch = DequantizePitch(command.pitch);
+    player.Update(step, world, command.GetInput());
+
+    // Part of the step rather than a client-side fixup, or the host and
+    // the prediction would disagree about it
+    if (player.Position.y < -CHUNK_SIZE) {
+        player.Position.y = RESPAWN_HEIGHT;
+        player.PreviousPosition = player.Position;
+        player.Velocity = glm::vec3(0.0f);
+    }
+}
+
+void WriteInputCommands(uint8_t senderSlot,
+                        int simulationRate,
+                        const InputCommand* commands,
+                        int count,
+                        std::vector<uint8_t>& out) {
+    BitWriter writer(out);
+    writer.Write((uint32_t)PacketType::InputCommands, 8);
+    writer.Write(senderSlot, PLAYER_SLOT_BITS);
+    writer.Write((uint32_t)simulationRate, SIMULATION_RATE_BITS);
+
+    // Only the newest sequence is sent; the rest count back from it
+    writer.Write(count > 0 ? commands[count - 1].sequence : 0, 16);
+    writer.Write(count, COMMAND_COUNT_BITS);
+    for (int i = 0; i < count; i++) {
+        writer.Write(commands[i].buttons, INPUT_BUTTON_BITS);
+        writer.Write(commands[i].yaw, 16);
+        writer.Write(commands[i].pitch, 8);
+    }
+    writer.Finish();
+}
+
+int ReadInputRate(BitReader& reader) {
+    return (int)reader.Read(SIMULATION_RATE_BITS);
+}
+
+int ReadInputCommands(BitReader& reader, InputCommand* commands) {
+    uint16_t newest = (uint16_t)reader.Read(16);
+    int count = (int)reader.Read(COMMAND_COUNT_BITS);
+    if (count > MAX_SENT_COMMANDS)
+        return -1;
+
+    for (int i = 0; i < count; i++) {
+        InputCommand& command = commands[i];
+        command.sequence = (uint16_t)(newest - (count - 1 - i));
+        command.buttons = (uint8_t)reader.Read(INPUT_BUTTON_BITS);
+        command.yaw = (uint16_t)reader.Read(16);
+        command.pitch = (uint8_t)reader.Read(8);
+    }
+    return reader.IsOverflowed() ? -1 : count;
+}
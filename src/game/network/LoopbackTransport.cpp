@@ -0,0 +1,55 @@
+#include "game/network/LoopbackTransport.hpp"
+
+#include <cstring>
+#include <iostream>
+
+LoopbackTransport::LoopbackTransport(uint8_t slot) : m_Slot(slot) {
+    if (slot >= MAX_SESSION_PLAYERS)
+        return;
+    if (s_Endpoints[slot])
+        std::cerr << "[Loopback] Slot " << (int)slot << " is already taken"
+                  << std::endl;
+    s_Endpoints[slot] = this;
+}
+
+LoopbackTransport::~LoopbackTransport() {
+    if (m_Slot < MAX_SESSION_PLAYERS && s_Endpoints[m_Slot] == this)
+        s_Endpoints[m_Slot] = nullptr;
+}
+
+void LoopbackTransport::Send(uint8_t slot, const void* data, size_t size) {
+    if (slot >= MAX_SESSION_PLAYERS || !s_Endpoints[slot])
+        return;
+    s_Endpoints[slot]->append(m_Slot, data, size);
+}
+
+void LoopbackTransport::append(uint8_t sender,
+                               const void* data,
+                               size_t size) {
+    uint32_t length = (uint32_t)size;
+    size_t offset = m_Inbox.size();
+    m_Inbox.resize(offset + sizeof(length) + 1 + size);
+    std::memcpy(m_Inbox.data() + offset, &length, sizeof(length));
+    m_Inbox[offset + sizeof(length)] = sender;
+    std::memcpy(m_Inbox.data() + offset + sizeof(length) + 1, data, size);
+}
+
+bool LoopbackTransport::Receive(TransportMessage& message) {
+    if (m_ReadOffset >= m_Reading.size()) {
+        if (m_Inbox.empty())
+            return false;
+
+        // Swapping keeps both buffers' capacity
+        m_Reading.swap(m_Inbox);
+        m_Inbox.clear();
+        m_ReadOffset = 0;
+    }
+
+    uint32_t length = 0;
+    std::memcpy(&length, m_Reading.data() + m_ReadOffset, sizeof(length));
+    message.sender = m_Reading[m_ReadOffset + sizeof(length)];
+    message.data = m_Reading.data() + m_ReadOffset + sizeof(length) + 1;
+    message.size = length;
+    m_ReadOffset += sizeof(length) + 1 + length;
+    return true;
+}
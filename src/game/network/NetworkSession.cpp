@@ -0,0 +1,325 @@
+#include "game/network/NetworkSession.hpp"
+#include "game/network/NetworkStats.hpp"
+#include "game/network/RemotePlayerStore.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace {
+// Type, sender slot, sequence, time, baseline flag and entry count
+const size_t MIN_STATE_PACKET_BYTES = 9;
+
+// Type, sender slot, simulation rate, newest sequence and command count
+const size_t MIN_INPUT_PACKET_BYTES = 6;
+} // namespace
+
+const NetworkSession::PacketHandler
+    NetworkSession::s_Handlers[(size_t)PacketType::Count] = {
+        {&NetworkSession::handlePlayerState, MIN_STATE_PACKET_BYTES},
+        {&NetworkSession::handleStateAck, sizeof(StateAckPacket)},
+        {&NetworkSession::handleInputCommands, MIN_INPUT_PACKET_BYTES},
+        {&NetworkSession::handlePlayerCorrection,
+         sizeof(PlayerCorrectionPacket)},
+};
+
+int NetworkSession::Receive() {
+    if (!m_Transport)
+        return 0;
+
+    int received = 0;
+    TransportMessage message;
+    while (m_Transport->Receive(message)) {
+        HandleMessage(message.sender, message.data, message.size);
+        received++;
+    }
+    return received;
+}
+
+void NetworkSession::HandleMessage(uint8_t sender,
+                                   const void* data,
+                                   size_t size) {
+    PacketBatch::ForEach(data, size, [&](const void* packet, size_t length) {
+        HandlePacket(sender, packet, length);
+    });
+}
+
+void NetworkSession::HandlePacket(uint8_t sender,
+                                  const void* data,
+                                  size_t size) {
+    if (sender >= MAX_SESSION_PLAYERS || size < sizeof(PacketType))
+        return;
+
+    uint8_t type = *(const uint8_t*)data;
+    if (type >= (uint8_t)PacketType::Count)
+        return;
+
+    const PacketHandler& handler = s_Handlers[type];
+    if (size < handler.size)
+        return;
+
+    handler.handle(sender, data, size);
+}
+
+void NetworkSession::handlePlayerState(uint8_t sender,
+                                       const void* data,
+                                       size_t size) {
+    BitReader reader(data, size);
+    reader.Read(8); // Type, already known
+    uint8_t claimed = (uint8_t)reader.Read(PLAYER_SLOT_BITS);
+
+    // Only the host says where players are; it takes inputs instead.
+    // Nothing to attach it to until the slot table says who this is.
+    if (IsHost() || sender != m_HostSlot || claimed != sender ||
+        m_SlotPlayers[sender] == 0)
+        return;
+
+    bool newest = false;
+    const Snapshot* snapshot = m_Decoders[sender].Read(reader, newest);
+    if (!snapshot)
+        return;
+
+    NetworkStats::CountReceived(size, (int)snapshot->entries.size());
+
+    // Ack everything that decoded, late or not; the sender only moves its
+    // baseline forward
+    if (m_LocalSlot != NO_PLAYER_SLOT) {
+        StateAckPacket ack;
+        ack.slot = m_LocalSlot;
+        ack.sequence = snapshot->sequence;
+        queue(sender, &ack, sizeof(ack), 0);
+    }
+
+    if (!newest)
+        return;
+
+    for (const SnapshotEntry& entry : snapshot->entries) {
+        // We are wherever our own prediction says
+        if (entry.slot == m_LocalSlot || m_SlotPlayers[entry.slot] == 0)
+            continue;
+
+        m_States[entry.slot] = entry.state;
+        m_HasState[entry.slot] = true;
+        RemotePlayerStore::ApplyState(m_SlotPlayers[entry.slot],
+                                      snapshot->time,
+                                      entry.state.GetPosition(),
+                                      entry.state.GetYaw(),
+                                      entry.state.GetPitch());
+    }
+}
+
+void NetworkSession::handleStateAck(uint8_t sender,
+                                    const void* data,
+                                    size_t size) {
+    const StateAckPacket* ack = (const StateAckPacket*)data;
+    NetworkStats::CountReceived(size, 0);
+
+    // Acking for someone else would move their baseline to a snapshot
+    // they never got
+    if (ack->slot != sender || m_SlotPlayers[sender] == 0)
+        return;
+
+    m_Encoder.Acknowledge(sender, ack->sequence);
+}
+
+void NetworkSession::handleInputCommands(uint8_t sender,
+                                         const void* data,
+                                         size_t size) {
+    BitReader reader(data, size);
+    reader.Read(8); // Type, already known
+    uint8_t claimed = (uint8_t)reader.Read(PLAYER_SLOT_BITS);
+
+    // Clients only ever steer their own player
+    if (!IsHost() || claimed != sender || sender == m_LocalSlot ||
+        m_SlotPlayers[sender] == 0)
+        return;
+
+    // Stepped at another rate, every command would land somewhere else
+    // here and the client would be corrected on each one
+    int rate = ReadInputRate(reader);
+    if (rate != m_SimulationRate) {
+        if (!m_WrongRate[sender])
+            std::cerr << "[Network] Slot " << (int)sender << " steps at "
+                      << rate << " Hz, the session at " << m_SimulationRate
+                      << " Hz; ignoring its input" << std::endl;
+        m_WrongRate[sender] = true;
+        return;
+    }
+
+    InputCommand commands[MAX_SENT_COMMANDS];
+    int count = ReadInputCommands(reader, commands);
+    if (count < 0)
+        return;
+
+    NetworkStats::CountReceived(size, 0);
+    m_Authorities[sender].ReceiveCommands(commands, count);
+}
+
+void NetworkSession::handlePlayerCorrection(uint8_t sender,
+                                            const void* data,
+                                            size_t size) {
+    // Peers can message each other directly; only the host may move us
+    if (IsHost() || sender != m_HostSlot)
+        return;
+
+    // Copied out, the message buffer has no alignment to speak of
+    PlayerCorrectionPacket correction;
+    std::memcpy(&correction, data, sizeof(correction));
+    NetworkStats::CountReceived(size, 0);
+    m_Prediction.ApplyCorrection(correction);
+}
+
+void NetworkSession::AssignSlot(uint8_t slot, uint64_t playerID) {
+    if (slot >= MAX_SESSION_PLAYERS || m_SlotPlayers[slot] == playerID)
+        return;
+
+    ReleaseSlot(slot);
+    m_SlotPlayers[slot] = playerID;
+}
+
+void NetworkSession::ReleaseSlot(uint8_t slot) {
+    if (slot >= MAX_SESSION_PLAYERS || m_SlotPlayers[slot] == 0)
+        return;
+
+    RemotePlayerStore::Remove(m_SlotPlayers[slot]);
+    m_SlotPlayers[slot] = 0;
+    m_HasState[slot] = false;
+    m_WrongRate[slot] = false;
+    m_Decoders[slot].Reset();
+    m_Encoder.Forget(slot);
+    m_Batches[slot].Clear();
+    m_Authorities[slot].Spawn(Player().Position);
+    if (m_LocalSlot == slot)
+        m_LocalSlot = NO_PLAYER_SLOT;
+    if (m_HostSlot == slot)
+        m_HostSlot = NO_PLAYER_SLOT;
+}
+
+int NetworkSession::FindSlot(uint64_t playerID) {
+    for (int slot = 0; slot < MAX_SESSION_PLAYERS; slot++) {
+        if (m_SlotPlayers[slot] == playerID)
+            return slot;
+    }
+    return -1;
+}
+
+void NetworkSession::SetLocalState(glm::vec3 position, float yaw, float pitch) {
+    if (m_LocalSlot == NO_PLAYER_SLOT)
+        return;
+
+    m_States[m_LocalSlot] = PlayerState::Quantize(position, yaw, pitch);
+    m_HasState[m_LocalSlot] = true;
+}
+
+void NetworkSession::SimulateClients(World& world, float step) {
+    m_Clock += step;
+    if (!IsHost())
+        return;
+
+    for (int slot = 0; slot < MAX_SESSION_PLAYERS; slot++) {
+        if (m_SlotPlayers[slot] != 0 && slot != m_LocalSlot)
+            m_Authorities[slot].Simulate(world, step);
+    }
+}
+
+void NetworkSession::SendTick() {
+    // Nobody could tell who it came from, or where to send it
+    if (m_LocalSlot == NO_PLAYER_SLOT || m_HostSlot == NO_PLAYER_SLOT)
+        return;
+
+    if (!IsHost()) {
+        if (m_Prediction.WriteCommands(
+                m_LocalSlot, m_SimulationRate, m_PacketBuffer))
+            queue(m_HostSlot, m_PacketBuffer.data(), m_PacketBuffer.size(), 0);
+        Flush();
+        return;
+    }
+
+    // Clients are wherever our copies of their players are
+    uint32_t time = GetTime();
+    for (int slot = 0; slot < MAX_SESSION_PLAYERS; slot++) {
+        if (m_SlotPlayers[slot] == 0 || slot == m_LocalSlot ||
+            !m_Authorities[slot].IsActive())
+            continue;
+
+        const Player& player = m_Authorities[slot].GetPlayer();
+        m_States[slot] =
+            PlayerState::Quantize(player.Position, player.Yaw, player.Pitch);
+        m_HasState[slot] = true;
+        RemotePlayerStore::ApplyState(m_SlotPlayers[slot],
+                                      time,
+                                      player.Position,
+                                      player.Yaw,
+                                      player.Pitch);
+    }
+
+    // Slots in order, as the encoder wants them
+    m_Encoder.Begin(time);
+    int states = 0;
+    for (int slot = 0; slot < MAX_SESSION_PLAYERS; slot++) {
+        if (m_HasState[slot]) {
+            m_Encoder.Add((uint8_t)slot, m_States[slot]);
+            states++;
+        }
+    }
+
+    for (int slot = 0; slot < MAX_SESSION_PLAYERS; slot++) {
+        if (m_SlotPlayers[slot] == 0 || slot == m_LocalSlot)
+            continue;
+
+        PlayerCorrectionPacket correction;
+        if (m_Authorities[slot].TakeCorrection(correction))
+            queue((uint8_t)slot, &correction, sizeof(correction), 0);
+        sendSnapshot((uint8_t)slot, states);
+    }
+
+    Flush();
+}
+
+void NetworkSession::sendSnapshot(uint8_t slot, int states) {
+    m_Encoder.Write(m_LocalSlot, slot, m_PacketBuffer);
+    queue(slot, m_PacketBuffer.data(), m_PacketBuffer.size(), states);
+}
+
+void NetworkSession::queue(uint8_t slot,
+                           const void* data,
+                           size_t size,
+                           int states) {
+    NetworkStats::CountSent(size, states);
+
+    PacketBatch& batch = m_Batches[slot];
+    if (batch.Add(data, size))
+        return;
+
+    // Full: send what is there and start over
+    if (m_Transport)
+        m_Transport->Send(slot, batch.GetData(), batch.GetSize());
+    batch.Clear();
+    batch.Add(data, size);
+}
+
+void NetworkSession::Flush() {
+    for (int slot = 0; slot < MAX_SESSION_PLAYERS; slot++) {
+        PacketBatch& batch = m_Batches[slot];
+        if (batch.IsEmpty())
+            continue;
+        if (m_Transport)
+            m_Transport->Send((uint8_t)slot, batch.GetData(), batch.GetSize());
+        batch.Clear();
+    }
+}
+
+uint32_t NetworkSession::GetTime() {
+    // Takes weeks to wrap
+    return (uint32_t)std::llround(m_Clock * 1000.0);
+}
+
+void NetworkSession::Reset() {
+    for (int slot = 0; slot < MAX_SESSION_PLAYERS; slot++)
+        ReleaseSlot((uint8_t)slot);
+    m_LocalSlot = NO_PLAYER_SLOT;
+    m_HostSlot = NO_PLAYER_SLOT;
+    m_Prediction.Reset();
+    NetworkStats::Reset();
+    m_Clock = 0.0;
+}
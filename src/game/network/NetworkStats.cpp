@@ -0,0 +1,52 @@
+#include "game/network/NetworkStats.hpp"
+
+#include <chrono>
+
+namespace {
+uint64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+} // namespace
+
+void NetworkStats::CountSent(size_t bytes, int states) {
+    m_Window.bytesSent += bytes;
+    m_Window.packetsSent++;
+    m_Window.statesSent += states;
+}
+
+void NetworkStats::CountReceived(size_t bytes, int states) {
+    m_Window.bytesReceived += bytes;
+    m_Window.packetsReceived++;
+    m_Window.statesReceived += states;
+}
+
+void NetworkStats::Update() {
+    uint64_t now = nowNs();
+    if (m_WindowStart == 0) {
+        m_WindowStart = now;
+        return;
+    }
+
+    double seconds = (now - m_WindowStart) / 1e9;
+    if (seconds < 1.0)
+        return;
+
+    float scale = (float)(1.0 / seconds);
+    m_Rates.bytesSent = m_Window.bytesSent * scale;
+    m_Rates.bytesReceived = m_Window.bytesReceived * scale;
+    m_Rates.packetsSent = m_Window.packetsSent * scale;
+    m_Rates.packetsReceived = m_Window.packetsReceived * scale;
+    m_Rates.statesSent = m_Window.statesSent * scale;
+    m_Rates.statesReceived = m_Window.statesReceived * scale;
+
+    m_Window = NetworkRates();
+    m_WindowStart = now;
+}
+
+void NetworkStats::Reset() {
+    m_Window = NetworkRates();
+    m_Rates = NetworkRates();
+    m_WindowStart = 0;
+}
@@ -0,0 +1,15 @@
+#include "game/network/PacketBatch.hpp"
+
+bool PacketBatch::Add(const void* data, size_t size) {
+    if (size == 0 || size > 0xFFFF)
+        return true; // Can't be framed; dropping it is all we can do
+
+    if (!m_Data.empty() && m_Data.size() + 2 + size > MAX_BATCH_BYTES)
+        return false;
+
+    m_Data.push_back((uint8_t)size);
+    m_Data.push_back((uint8_t)(size >> 8));
+    const uint8_t* bytes = (const uint8_t*)data;
+    m_Data.insert(m_Data.end(), bytes, bytes + size);
+    return true;
+}
@@ -0,0 +1,93 @@
+#include "game/network/PlayerAuthority.hpp"
+#include "game/network/Snapshot.hpp"
+
+#include <algorithm>
+
+namespace {
+// Steps of time a quiet client can bank, so a burst after a network
+// hiccup is applied at once instead of falling further behind
+const int MAX_COMMAND_CREDIT = 8;
+
+// A client this far ahead of the host's clock loses its oldest commands
+const int MAX_QUEUED_COMMANDS = MAX_SENT_COMMANDS;
+} // namespace
+
+PlayerAuthority::PlayerAuthority() {
+    Spawn(m_Player.Position);
+}
+
+void PlayerAuthority::Spawn(glm::vec3 position) {
+    m_Player.Position = position;
+    m_Player.PreviousPosition = position;
+    m_Player.Velocity = glm::vec3(0.0f);
+    m_Player.IsGrounded = false;
+    m_HasReceived = false;
+    m_Changed = false;
+    m_Credit = 0;
+    m_Dropped = 0;
+}
+
+void PlayerAuthority::ReceiveCommands(const InputCommand* commands,
+                                      int count) {
+    if (count == 0)
+        return;
+
+    uint16_t newest = commands[count - 1].sequence;
+    if (m_HasReceived && !IsSequenceNewer(newest, m_Received))
+        return;
+
+    // Whatever came before the first packet is none of our business
+    if (!m_HasReceived) {
+        m_Applied = (uint16_t)(commands[0].sequence - 1);
+
+        // Nor is anything queued for whoever had this slot before
+        for (InputCommand& queued : m_Queue)
+            queued.sequence = m_Applied;
+    }
+    m_Received = newest;
+    m_HasReceived = true;
+
+    if (GetQueued() > MAX_QUEUED_COMMANDS) {
+        uint16_t oldest = (uint16_t)(m_Received - MAX_QUEUED_COMMANDS);
+        m_Dropped += (uint16_t)(oldest - m_Applied);
+        m_Applied = oldest;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (IsSequenceNewer(commands[i].sequence, m_Applied))
+            m_Queue[commands[i].sequence % INPUT_HISTORY] = commands[i];
+    }
+}
+
+void PlayerAuthority::Simulate(World& world, float step) {
+    m_Credit = std::min(m_Credit + 1, MAX_COMMAND_CREDIT);
+
+    while (m_Credit > 0 && GetQueued() > 0) {
+        m_Applied++;
+        m_Changed = true;
+
+        // A slot still holding an older command means this one was lost
+        const InputCommand& command = m_Queue[m_Applied % INPUT_HISTORY];
+        if (command.sequence != m_Applied) {
+            m_Dropped++;
+            continue;
+        }
+
+        SimulateCommand(m_Player, world, command, step);
+        m_Credit--;
+    }
+}
+
+bool PlayerAuthority::TakeCorrection(PlayerCorrectionPacket& correction) {
+    if (!m_Changed)
+        return false;
+    m_Changed = false;
+
+    correction.sequence = m_Applied;
+    for (int i = 0; i < 3; i++) {
+        correction.position[i] = m_Player.Position[i];
+        correction.velocity[i] = m_Player.Velocity[i];
+    }
+    correction.grounded = m_Player.IsGrounded ? 1 : 0;
+    return true;
+}
@@ -0,0 +1,129 @@
+#include "game/network/PlayerPrediction.hpp"
+#include "game/Player.hpp"
+#include "game/network/Snapshot.hpp"
+
+#include <algorithm>
+
+namespace {
+// Host and client run the same code, but may not be the same build; a
+// different compiler is allowed to round differently
+const float CORRECTION_TOLERANCE = 0.001f;
+} // namespace
+
+void PlayerPrediction::Step(Player& player,
+                            World& world,
+                            const PlayerInput& input,
+                            float step) {
+    // Before the replay moves them
+    float yaw = player.Yaw;
+    float pitch = player.Pitch;
+
+    m_Step = step;
+    reconcile(player, world);
+
+    m_Sequence++;
+    Entry& entry = m_History[m_Sequence % INPUT_HISTORY];
+    entry.command = InputCommand::Make(m_Sequence, input, yaw, pitch);
+    simulate(entry, player, world);
+    m_Count = std::min(m_Count + 1, INPUT_HISTORY);
+}
+
+void PlayerPrediction::simulate(Entry& entry, Player& player, World& world) {
+    SimulateCommand(player, world, entry.command, m_Step);
+    entry.position = player.Position;
+    entry.velocity = player.Velocity;
+    entry.grounded = player.IsGrounded;
+}
+
+void PlayerPrediction::ApplyCorrection(
+    const PlayerCorrectionPacket& correction) {
+    // Stale, or about a command we never made (e.g. from before a Reset)
+    if (m_HasAcked && !IsSequenceNewer(correction.sequence, m_Acked))
+        return;
+    if (m_Count == 0 || IsSequenceNewer(correction.sequence, m_Sequence))
+        return;
+
+    m_Acked = correction.sequence;
+    m_HasAcked = true;
+    m_Correction = correction;
+    m_HasCorrection = true;
+}
+
+void PlayerPrediction::reconcile(Player& player, World& world) {
+    if (!m_HasCorrection)
+        return;
+    m_HasCorrection = false;
+
+    const PlayerCorrectionPacket& correction = m_Correction;
+    glm::vec3 position(correction.position[0],
+                       correction.position[1],
+                       correction.position[2]);
+    glm::vec3 velocity(correction.velocity[0],
+                       correction.velocity[1],
+                       correction.velocity[2]);
+    bool grounded = correction.grounded != 0;
+
+    // Older than anything remembered: all we can do is take the host's word
+    uint16_t age = (uint16_t)(m_Sequence - correction.sequence);
+    if (age >= m_Count) {
+        m_LastError = glm::distance(player.Position, position);
+        m_Corrections++;
+        player.Position = position;
+        player.PreviousPosition = position;
+        player.Velocity = velocity;
+        player.IsGrounded = grounded;
+        return;
+    }
+
+    Entry& acked = m_History[correction.sequence % INPUT_HISTORY];
+    float error = glm::distance(acked.position, position);
+    if (error <= CORRECTION_TOLERANCE &&
+        glm::distance(acked.velocity, velocity) <= CORRECTION_TOLERANCE &&
+        acked.grounded == grounded)
+        return;
+
+    m_LastError = error;
+    m_Corrections++;
+
+    acked.position = position;
+    acked.velocity = velocity;
+    acked.grounded = grounded;
+    player.Position = position;
+    player.Velocity = velocity;
+    player.IsGrounded = grounded;
+
+    for (uint16_t sequence = (uint16_t)(correction.sequence + 1);
+         sequence != (uint16_t)(m_Sequence + 1);
+         sequence++)
+        simulate(m_History[sequence % INPUT_HISTORY], player, world);
+}
+
+bool PlayerPrediction::WriteCommands(uint8_t senderSlot,
+                                     int simulationRate,
+                                     std::vector<uint8_t>& out) const {
+    int count = std::min(GetUnacknowledged(), MAX_SENT_COMMANDS);
+    if (count == 0)
+        return false;
+
+    InputCommand commands[MAX_SENT_COMMANDS];
+    for (int i = 0; i < count; i++) {
+        uint16_t sequence = (uint16_t)(m_Sequence - (count - 1 - i));
+        commands[i] = m_History[sequence % INPUT_HISTORY].command;
+    }
+    WriteInputCommands(senderSlot, simulationRate, commands, count, out);
+    return true;
+}
+
+int PlayerPrediction::GetUnacknowledged() const {
+    if (!m_HasAcked)
+        return m_Count;
+    return std::min((int)(uint16_t)(m_Sequence - m_Acked), m_Count);
+}
+
+void PlayerPrediction::Reset() {
+    m_Count = 0;
+    m_HasAcked = false;
+    m_HasCorrection = false;
+    m_Corrections = 0;
+    m_LastError = 0.0f;
+}
@@ -0,0 +1,214 @@
+#include "game/network/RemotePlayerStore.hpp"
+#include "core/MemoryTracker.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Longest a player keeps moving on its last velocity once packets stop
+const double MAX_EXTRAPOLATION = 0.25;
+
+// How fast the clock offset creeps back up after latency rises for good
+const double CLOCK_OFFSET_RELAX = 0.01;
+
+// One entry in every array plus a hash node
+const int64_t PLAYER_ENTRY_BYTES =
+    sizeof(uint64_t) + 3 * sizeof(glm::vec3) + 7 * sizeof(float) +
+    sizeof(double) + sizeof(std::pair<const uint64_t, uint32_t>) +
+    2 * sizeof(void*);
+
+// Yaw b, moved by whole turns to within half a turn of a, so blending
+// takes the short way round
+float nearestAngle(float a, float b) {
+    return a + std::remainder(b - a, 360.0f);
+}
+} // namespace
+
+void RemotePlayerStore::ApplyState(uint64_t steamID,
+                                   uint32_t timeMs,
+                                   glm::vec3 position,
+                                   float yaw,
+                                   float pitch) {
+    // One hash lookup either finds the player or makes room for it
+    auto [it, inserted] = m_Index.try_emplace(steamID, (uint32_t)m_Ids.size());
+    if (inserted)
+        add(steamID, position);
+
+    uint32_t i = it->second;
+    StateBuffer& buffer = m_Buffers[i];
+    double time = timeMs / 1000.0;
+
+    uint32_t newest = (buffer.next + STATE_BUFFER_SIZE - 1) % STATE_BUFFER_SIZE;
+    if (buffer.count > 0 && time <= buffer.times[newest])
+        return;
+
+    // The lowest offset seen is the fastest the network has been; latency
+    // above it is jitter the delay has to cover
+    double& offset = m_ClockOffsets[i];
+    double measured = m_Now - time;
+    if (buffer.count == 0 || measured < offset)
+        offset = measured;
+    else
+        offset += (measured - offset) * CLOCK_OFFSET_RELAX;
+
+    if (time < m_Now - offset - m_InterpolationDelay)
+        m_LateStates++;
+
+    buffer.times[buffer.next] = time;
+    buffer.positions[buffer.next] = position;
+    buffer.yaws[buffer.next] = yaw;
+    buffer.pitches[buffer.next] = pitch;
+    buffer.next = (buffer.next + 1) % STATE_BUFFER_SIZE;
+    buffer.count = std::min(buffer.count + 1, (uint32_t)STATE_BUFFER_SIZE);
+
+    // Increment packet counter for tickrate calculation
+    s_PacketsReceivedThisSecond++;
+}
+
+void RemotePlayerStore::add(uint64_t steamID, glm::vec3 position) {
+    // New players start where they are instead of sliding in from zero
+    m_Ids.push_back(steamID);
+    m_Positions.push_back(position);
+    m_Yaws.push_back(0.0f);
+    m_Pitches.push_back(0.0f);
+    m_Buffers.emplace_back();
+    m_ClockOffsets.push_back(0.0);
+
+    MemoryTracker::Add(MemoryCategory::Network,
+                       PLAYER_ENTRY_BYTES + sizeof(StateBuffer));
+}
+
+void RemotePlayerStore::Interpolate(float deltaTime) {
+    m_Now += deltaTime;
+
+    size_t count = m_Ids.size();
+    m_FromPositions.resize(count);
+    m_ToPositions.resize(count);
+    m_FromYaws.resize(count);
+    m_ToYaws.resize(count);
+    m_FromPitches.resize(count);
+    m_ToPitches.resize(count);
+    m_Blends.resize(count);
+
+    m_ExtrapolatingCount = 0;
+    m_BufferDepthTotal = 0;
+    for (uint32_t i = 0; i < count; i++)
+        sample(i, m_Now);
+    m_AverageBufferDepth = count ? (float)m_BufferDepthTotal / count : 0.0f;
+
+    // Plain arrays and no branches, so the compiler can vectorise it
+    for (size_t i = 0; i < count; i++) {
+        float t = m_Blends[i];
+        m_Positions[i] = m_FromPositions[i] * (1.0f - t) + m_ToPositions[i] * t;
+        m_Yaws[i] = m_FromYaws[i] * (1.0f - t) + m_ToYaws[i] * t;
+        m_Pitches[i] = m_FromPitches[i] * (1.0f - t) + m_ToPitches[i] * t;
+    }
+}
+
+void RemotePlayerStore::sample(uint32_t i, double now) {
+    const StateBuffer& buffer = m_Buffers[i];
+    if (buffer.count == 0) {
+        // Nothing yet; hold still where it is
+        m_FromPositions[i] = m_ToPositions[i] = m_Positions[i];
+        m_FromYaws[i] = m_ToYaws[i] = m_Yaws[i];
+        m_FromPitches[i] = m_ToPitches[i] = m_Pitches[i];
+        m_Blends[i] = 0.0f;
+        return;
+    }
+
+    // k-th oldest state
+    uint32_t oldest = (buffer.next + STATE_BUFFER_SIZE - buffer.count) %
+                      STATE_BUFFER_SIZE;
+    auto at = [&](uint32_t k) { return (oldest + k) % STATE_BUFFER_SIZE; };
+
+    // The newest state at or before the drawn time
+    double renderTime = now - m_ClockOffsets[i] - m_InterpolationDelay;
+    uint32_t k = 0;
+    while (k + 1 < buffer.count && buffer.times[at(k + 1)] <= renderTime)
+        k++;
+    m_BufferDepthTotal += buffer.count - 1 - k;
+
+    uint32_t from = at(k);
+    uint32_t to = from;
+    float blend = 0.0f;
+    if (k + 1 < buffer.count) {
+        // Between two states
+        to = at(k + 1);
+        double span = buffer.times[to] - buffer.times[from];
+        blend = (float)std::clamp((renderTime - buffer.times[from]) / span,
+                                  0.0,
+                                  1.0);
+    } else if (buffer.count >= 2 && renderTime > buffer.times[from]) {
+        // Past the newest state: keep going the way the last two went, for
+        // a little while
+        to = from;
+        from = at(k - 1);
+        double span = buffer.times[to] - buffer.times[from];
+        double late = std::min(renderTime - buffer.times[to],
+                               MAX_EXTRAPOLATION);
+        blend = (float)(1.0 + late / span);
+        m_ExtrapolatingCount++;
+    }
+
+    m_FromPositions[i] = buffer.positions[from];
+    m_ToPositions[i] = buffer.positions[to];
+    m_FromYaws[i] = buffer.yaws[from];
+    m_ToYaws[i] = nearestAngle(buffer.yaws[from], buffer.yaws[to]);
+    m_FromPitches[i] = buffer.pitches[from];
+    m_ToPitches[i] = buffer.pitches[to];
+    m_Blends[i] = blend;
+}
+
+void RemotePlayerStore::Remove(uint64_t steamID) {
+    auto it = m_Index.find(steamID);
+    if (it == m_Index.end())
+        return;
+
+    // Move the last player into the hole so the arrays stay dense
+    uint32_t i = it->second;
+    uint32_t last = (uint32_t)m_Ids.size() - 1;
+    if (i != last) {
+        m_Ids[i] = m_Ids[last];
+        m_Positions[i] = m_Positions[last];
+        m_Yaws[i] = m_Yaws[last];
+        m_Pitches[i] = m_Pitches[last];
+        m_Buffers[i] = m_Buffers[last];
+        m_ClockOffsets[i] = m_ClockOffsets[last];
+        m_Index[m_Ids[i]] = i;
+    }
+
+    m_Ids.pop_back();
+    m_Positions.pop_back();
+    m_Yaws.pop_back();
+    m_Pitches.pop_back();
+    m_Buffers.pop_back();
+    m_ClockOffsets.pop_back();
+    m_Index.erase(it);
+
+    MemoryTracker::Remove(MemoryCategory::Network,
+                          PLAYER_ENTRY_BYTES + sizeof(StateBuffer));
+}
+
+int RemotePlayerStore::GetAndResetPacketCount() {
+    int count = s_PacketsReceivedThisSecond;
+    s_PacketsReceivedThisSecond = 0;
+    return count;
+}
+
+void RemotePlayerStore::Clear() {
+    MemoryTracker::Remove(MemoryCategory::Network,
+                          (int64_t)m_Ids.size() *
+                              (PLAYER_ENTRY_BYTES + sizeof(StateBuffer)));
+    m_Ids.clear();
+    m_Positions.clear();
+    m_Yaws.clear();
+    m_Pitches.clear();
+    m_Buffers.clear();
+    m_ClockOffsets.clear();
+    m_Index.clear();
+    m_Now = 0.0;
+    m_AverageBufferDepth = 0.0f;
+    m_ExtrapolatingCount = 0;
+    m_LateStates = 0;
+    s_PacketsReceivedThisSecond = 0;
+}
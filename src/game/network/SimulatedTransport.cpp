@@ -0,0 +1,156 @@
+#include "game/network/SimulatedTransport.hpp"
+#include "core/CommandLine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+// Held back this much longer than usual, a reordered message arrives after
+// at least one later network tick's
+const double REORDER_DELAY = 0.05;
+
+double now() {
+    using Clock = std::chrono::steady_clock;
+    return std::chrono::duration<double>(Clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+NetworkConditions NetworkConditions::FromCommandLine() {
+    NetworkConditions conditions;
+    conditions.latencyMs = CommandLine::GetFloat("--latency", 0.0f);
+    conditions.jitterMs = CommandLine::GetFloat("--jitter", 0.0f);
+    conditions.lossPercent = CommandLine::GetFloat("--loss", 0.0f);
+    conditions.duplicatePercent = CommandLine::GetFloat("--duplicate", 0.0f);
+    conditions.reorderPercent = CommandLine::GetFloat("--reorder", 0.0f);
+    return conditions;
+}
+
+SimulatedTransport::SimulatedTransport(Transport& inner, uint32_t seed)
+    : m_Inner(inner), m_Random(seed) {}
+
+void SimulatedTransport::SetConditions(const NetworkConditions& conditions) {
+    m_Conditions = conditions;
+}
+
+void SimulatedTransport::SetConditions(uint8_t slot,
+                                       const NetworkConditions& conditions) {
+    if (slot >= MAX_SESSION_PLAYERS)
+        return;
+    m_SlotConditions[slot] = conditions;
+    m_HasSlotConditions[slot] = true;
+}
+
+void SimulatedTransport::ClearConditions(uint8_t slot) {
+    if (slot < MAX_SESSION_PLAYERS)
+        m_HasSlotConditions[slot] = false;
+}
+
+const NetworkConditions& SimulatedTransport::GetConditions(uint8_t slot) const {
+    return HasConditions(slot) ? m_SlotConditions[slot] : m_Conditions;
+}
+
+bool SimulatedTransport::HasConditions(uint8_t slot) const {
+    return slot < MAX_SESSION_PLAYERS && m_HasSlotConditions[slot];
+}
+
+void SimulatedTransport::Send(uint8_t slot, const void* data, size_t size) {
+    deliverDue();
+    m_Stats.sent++;
+
+    const NetworkConditions& conditions = GetConditions(slot);
+    if (conditions.IsIdeal()) {
+        m_Inner.Send(slot, data, size);
+        return;
+    }
+
+    if (roll(conditions.lossPercent)) {
+        m_Stats.dropped++;
+        return;
+    }
+
+    hold(slot, data, size, delayFor(conditions));
+    if (roll(conditions.duplicatePercent)) {
+        hold(slot, data, size, delayFor(conditions));
+        m_Stats.duplicated++;
+    }
+}
+
+double SimulatedTransport::delayFor(const NetworkConditions& conditions) {
+    double delay = conditions.latencyMs;
+    if (conditions.jitterMs > 0.0f) {
+        std::uniform_real_distribution<double> jitter(-conditions.jitterMs,
+                                                      conditions.jitterMs);
+        delay += jitter(m_Random);
+    }
+    delay = std::max(delay, 0.0) / 1000.0;
+
+    if (roll(conditions.reorderPercent)) {
+        delay += REORDER_DELAY;
+        m_Stats.reordered++;
+    }
+    return delay;
+}
+
+bool SimulatedTransport::roll(float percent) {
+    if (percent <= 0.0f)
+        return false;
+    std::uniform_real_distribution<float> chance(0.0f, 100.0f);
+    return chance(m_Random) < percent;
+}
+
+void SimulatedTransport::hold(uint8_t slot,
+                              const void* data,
+                              size_t size,
+                              double delay) {
+    Pending pending;
+    pending.due = now() + delay;
+    pending.slot = slot;
+    if (!m_FreeBuffers.empty()) {
+        pending.data.swap(m_FreeBuffers.back());
+        m_FreeBuffers.pop_back();
+    }
+    pending.data.resize(size);
+    std::memcpy(pending.data.data(), data, size);
+
+    m_NextDue = m_Pending.empty() ? pending.due
+                                  : std::min(m_NextDue, pending.due);
+    m_Pending.push_back(std::move(pending));
+    m_Stats.inFlight = (int)m_Pending.size();
+}
+
+void SimulatedTransport::deliverDue() {
+    if (m_Pending.empty())
+        return;
+
+    double time = now();
+    if (time < m_NextDue)
+        return;
+
+    // Due messages go out in whatever order; no transport promises one
+    m_NextDue = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < m_Pending.size();) {
+        Pending& pending = m_Pending[i];
+        if (pending.due > time) {
+            m_NextDue = std::min(m_NextDue, pending.due);
+            i++;
+            continue;
+        }
+
+        m_Inner.Send(pending.slot, pending.data.data(), pending.data.size());
+        m_FreeBuffers.push_back(std::move(pending.data));
+        if (i + 1 < m_Pending.size())
+            pending = std::move(m_Pending.back());
+        m_Pending.pop_back();
+    }
+    m_Stats.inFlight = (int)m_Pending.size();
+}
+
+bool SimulatedTransport::Receive(TransportMessage& message) {
+    deliverDue();
+    return m_Inner.Receive(message);
+}
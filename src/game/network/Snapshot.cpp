@@ -0,0 +1,275 @@
+#include "game/network/Snapshot.hpp"
+#include "game/network/NetworkPackets.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Delta sizes, picked per value with a 2-bit class. Walking moves a few
+// steps per tick; the last class is a plain 32-bit value.
+const int DELTA_CLASS_BITS[4] = {5, 9, 14, 32};
+
+const int ENTRY_COUNT_BITS = PLAYER_SLOT_BITS + 1;
+
+// Small magnitudes of either sign become small unsigned values
+uint32_t zigzag(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+int32_t unzigzag(uint32_t value) {
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+void writeDelta(BitWriter& writer, int32_t value, int32_t base) {
+    uint32_t delta = zigzag((int32_t)((uint32_t)value - (uint32_t)base));
+    if (delta == 0) {
+        writer.WriteBool(false);
+        return;
+    }
+
+    writer.WriteBool(true);
+    int size = 0;
+    while (size < 3 && delta >> DELTA_CLASS_BITS[size] != 0)
+        size++;
+    writer.Write(size, 2);
+    writer.Write(delta, DELTA_CLASS_BITS[size]);
+}
+
+int32_t readDelta(BitReader& reader, int32_t base) {
+    if (!reader.ReadBool())
+        return base;
+
+    int size = reader.Read(2);
+    int32_t delta = unzigzag(reader.Read(DELTA_CLASS_BITS[size]));
+    return (int32_t)((uint32_t)base + (uint32_t)delta);
+}
+
+// A player missing from the baseline is sent as a delta from all zeros,
+// minus the "unchanged" bit
+void writeState(BitWriter& writer,
+                const PlayerState& state,
+                const PlayerState* baseline) {
+    PlayerState zero;
+    const PlayerState& base = baseline ? *baseline : zero;
+    if (baseline) {
+        bool changed = !(state == base);
+        writer.WriteBool(changed);
+        if (!changed)
+            return;
+    }
+
+    writeDelta(writer, state.x, base.x);
+    writeDelta(writer, state.y, base.y);
+    writeDelta(writer, state.z, base.z);
+
+    writer.WriteBool(state.yaw != base.yaw);
+    if (state.yaw != base.yaw)
+        writer.Write(state.yaw, 16);
+    writer.WriteBool(state.pitch != base.pitch);
+    if (state.pitch != base.pitch)
+        writer.Write(state.pitch, 8);
+}
+
+PlayerState readState(BitReader& reader, const PlayerState* baseline) {
+    PlayerState base;
+    if (baseline) {
+        base = *baseline;
+        if (!reader.ReadBool())
+            return base;
+    }
+
+    PlayerState state;
+    state.x = readDelta(reader, base.x);
+    state.y = readDelta(reader, base.y);
+    state.z = readDelta(reader, base.z);
+    state.yaw = reader.ReadBool() ? (uint16_t)reader.Read(16) : base.yaw;
+    state.pitch = reader.ReadBool() ? (uint8_t)reader.Read(8) : base.pitch;
+    return state;
+}
+
+// The baseline entry for slot, if it has one. Both lists are sorted by
+// slot, so cursor only ever moves forward.
+const PlayerState* findBaseline(const Snapshot* baseline,
+                                size_t& cursor,
+                                uint8_t slot) {
+    if (!baseline)
+        return nullptr;
+
+    const std::vector<SnapshotEntry>& entries = baseline->entries;
+    while (cursor < entries.size() && entries[cursor].slot < slot)
+        cursor++;
+    if (cursor < entries.size() && entries[cursor].slot == slot)
+        return &entries[cursor].state;
+    return nullptr;
+}
+
+} // namespace
+
+uint16_t QuantizeYaw(float yaw) {
+    // Yaw keeps growing as the player spins; only the angle matters
+    float turns = yaw / 360.0f;
+    turns -= std::floor(turns);
+    return (uint16_t)((uint32_t)std::lround(turns * 65536.0f) & 0xFFFF);
+}
+
+float DequantizeYaw(uint16_t yaw) {
+    return yaw * (360.0f / 65536.0f);
+}
+
+uint8_t QuantizePitch(float pitch) {
+    float clamped = std::clamp(pitch, -90.0f, 90.0f);
+    return (uint8_t)std::lround((clamped + 90.0f) / 180.0f * 255.0f);
+}
+
+float DequantizePitch(uint8_t pitch) {
+    return pitch * (180.0f / 255.0f) - 90.0f;
+}
+
+PlayerState PlayerState::Quantize(glm::vec3 position, float yaw, float pitch) {
+    PlayerState state;
+    state.x = (int32_t)std::lround(position.x * POSITION_SCALE);
+    state.y = (int32_t)std::lround(position.y * POSITION_SCALE);
+    state.z = (int32_t)std::lround(position.z * POSITION_SCALE);
+    state.yaw = QuantizeYaw(yaw);
+    state.pitch = QuantizePitch(pitch);
+    return state;
+}
+
+glm::vec3 PlayerState::GetPosition() const {
+    return glm::vec3(x, y, z) / POSITION_SCALE;
+}
+
+float PlayerState::GetYaw() const {
+    return DequantizeYaw(yaw);
+}
+
+float PlayerState::GetPitch() const {
+    return DequantizePitch(pitch);
+}
+
+SnapshotEncoder::SnapshotEncoder() {
+    std::fill(std::begin(m_Acked), std::end(m_Acked), -1);
+}
+
+void SnapshotEncoder::Begin(uint32_t timeMs) {
+    m_Sequence++;
+    Snapshot& snapshot = m_History[m_Sequence % SNAPSHOT_HISTORY];
+    snapshot.sequence = m_Sequence;
+    snapshot.time = timeMs;
+    snapshot.valid = true;
+    snapshot.entries.clear();
+}
+
+void SnapshotEncoder::Add(uint8_t slot, const PlayerState& state) {
+    m_History[m_Sequence % SNAPSHOT_HISTORY].entries.push_back({slot, state});
+}
+
+void SnapshotEncoder::Write(uint8_t senderSlot,
+                            uint8_t targetSlot,
+                            std::vector<uint8_t>& out) {
+    const Snapshot& current = m_History[m_Sequence % SNAPSHOT_HISTORY];
+
+    // Only delta against a snapshot the receiver is known to still have
+    const Snapshot* baseline = nullptr;
+    int32_t acked = m_Acked[targetSlot];
+    if (acked >= 0) {
+        uint16_t age = (uint16_t)(m_Sequence - acked);
+        const Snapshot& candidate = m_History[acked % SNAPSHOT_HISTORY];
+        if (age >= 1 && age < SNAPSHOT_HISTORY && candidate.valid &&
+            candidate.sequence == acked)
+            baseline = &candidate;
+        else if (age >= SNAPSHOT_HISTORY)
+            m_Acked[targetSlot] = -1; // Too old to ever be useful again
+    }
+
+    BitWriter writer(out);
+    writer.Write((uint32_t)PacketType::PlayerState, 8);
+    writer.Write(senderSlot, PLAYER_SLOT_BITS);
+    writer.Write(current.sequence, 16);
+    writer.Write(current.time, 32);
+    writer.WriteBool(baseline != nullptr);
+    if (baseline)
+        writer.Write((uint16_t)(current.sequence - baseline->sequence),
+                     SNAPSHOT_AGE_BITS);
+
+    writer.Write((uint32_t)current.entries.size(), ENTRY_COUNT_BITS);
+    size_t cursor = 0;
+    for (const SnapshotEntry& entry : current.entries) {
+        writer.Write(entry.slot, PLAYER_SLOT_BITS);
+        writeState(
+            writer, entry.state, findBaseline(baseline, cursor, entry.slot));
+    }
+    writer.Finish();
+}
+
+void SnapshotEncoder::Acknowledge(uint8_t targetSlot, uint16_t sequence) {
+    // Ignore acks for snapshots we never sent or already forgot
+    uint16_t age = (uint16_t)(m_Sequence - sequence);
+    if (age >= SNAPSHOT_HISTORY)
+        return;
+
+    int32_t& acked = m_Acked[targetSlot];
+    if (acked < 0 || IsSequenceNewer(sequence, (uint16_t)acked))
+        acked = sequence;
+}
+
+void SnapshotEncoder::Forget(uint8_t targetSlot) {
+    m_Acked[targetSlot] = -1;
+}
+
+const Snapshot* SnapshotDecoder::Read(BitReader& reader, bool& newest) {
+    newest = false;
+    uint16_t sequence = (uint16_t)reader.Read(16);
+    uint32_t time = reader.Read(32);
+
+    const Snapshot* baseline = nullptr;
+    if (reader.ReadBool()) {
+        uint16_t age = (uint16_t)reader.Read(SNAPSHOT_AGE_BITS);
+        uint16_t baselineSequence = (uint16_t)(sequence - age);
+        const Snapshot& candidate =
+            m_History[baselineSequence % SNAPSHOT_HISTORY];
+        if (age == 0 || !candidate.valid ||
+            candidate.sequence != baselineSequence)
+            return nullptr;
+        baseline = &candidate;
+    }
+
+    uint32_t count = reader.Read(ENTRY_COUNT_BITS);
+    if (count > (uint32_t)MAX_SESSION_PLAYERS || reader.IsOverflowed())
+        return nullptr;
+
+    // Age is never 0, so the baseline is never the snapshot being replaced
+    Snapshot& snapshot = m_History[sequence % SNAPSHOT_HISTORY];
+    snapshot.valid = false;
+    snapshot.sequence = sequence;
+    snapshot.time = time;
+    snapshot.entries.clear();
+
+    size_t cursor = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t slot = (uint8_t)reader.Read(PLAYER_SLOT_BITS);
+        if (!snapshot.entries.empty() && slot <= snapshot.entries.back().slot)
+            return nullptr;
+
+        PlayerState state =
+            readState(reader, findBaseline(baseline, cursor, slot));
+        snapshot.entries.push_back({slot, state});
+    }
+    if (reader.IsOverflowed())
+        return nullptr;
+
+    snapshot.valid = true;
+    if (!m_HasNewest || IsSequenceNewer(sequence, m_Newest)) {
+        m_Newest = sequence;
+        m_HasNewest = true;
+        newest = true;
+    }
+    return &snapshot;
+}
+
+void SnapshotDecoder::Reset() {
+    for (Snapshot& snapshot : m_History)
+        snapshot.valid = false;
+    m_HasNewest = false;
+}
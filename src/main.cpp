@@ -1,6 +1,16 @@
 #include "core/Application.hpp"
+#include "core/CommandLine.hpp"
+#include "core/HeadlessApplication.hpp"
 
 int main(int argc, char **argv) {
+    CommandLine::Parse(argc, argv);
+
+    // --headless runs the simulation without a window, GL or Steam
+    if (CommandLine::HasFlag("--headless")) {
+        HeadlessApplication server;
+        return server.Run();
+    }
+
     Application app;
     return app.Run();
 }
\ No newline at end of file
@@ -1,9 +1,21 @@
 #include "platform/Steam.hpp"
+#include "core/Profiler.hpp"
 #include "game/network/NetworkPackets.hpp"
+#include "game/network/NetworkSession.hpp"
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <string>
 #include "steam/isteammatchmaking.h"
 #include "steam/steamnetworkingtypes.h"
 
+namespace {
+// Lobby data key holding the Steam ID in a session slot
+std::string slotKey(int slot) {
+    return "slot" + std::to_string(slot);
+}
+} // namespace
+
 Steam::Steam() {
     // Constructor - STEAM_CALLBACK macro handles initialization automatically
 }
@@ -28,6 +40,11 @@ bool Steam::Init() {
     // Create singleton instance to register callbacks
     GetInstance();
 
+    // Ideal unless asked otherwise, in which case the session runs over a
+    // deliberately bad connection; the network window can change it live
+    m_Simulator.SetConditions(NetworkConditions::FromCommandLine());
+    NetworkSession::SetTransport(&m_Simulator);
+
     return true;
 }
 
@@ -75,7 +92,8 @@ void Steam::CreateLobby() {
     std::cout << "Steam: Requesting Lobby Creation..." << std::endl;
     // Use FriendsOnly type so friends can discover the lobby
     m_LobbyCreateCall =
-        SteamMatchmaking()->CreateLobby(k_ELobbyTypeFriendsOnly, 4);
+        SteamMatchmaking()->CreateLobby(k_ELobbyTypeFriendsOnly,
+                                        MAX_SESSION_PLAYERS);
 }
 
 void Steam::OnLobbyCreated(LobbyCreated_t* pCallback, bool bIOFailure) {
@@ -89,6 +107,7 @@ void Steam::OnLobbyCreated(LobbyCreated_t* pCallback, bool bIOFailure) {
     SteamMatchmaking()->SetLobbyData(
         m_CurrentLobbyID, "game_id", "orix_engine");
     SteamMatchmaking()->SetLobbyData(m_CurrentLobbyID, "version", "1.0");
+    assignSlots();
 
     std::cout << "Steam: Lobby Created! ID: " << pCallback->m_ulSteamIDLobby
               << std::endl;
@@ -120,6 +139,7 @@ void Steam::OnLobbyEntered(LobbyEnter_t* pCallback, bool bIOFailure) {
         k_EChatRoomEnterResponseSuccess) {
         m_CurrentLobbyID = pCallback->m_ulSteamIDLobby;
         std::cout << "Steam: Successfully joined the lobby!" << std::endl;
+        readSlots();
     } else {
         std::cerr << "Steam: Failed to join lobby. Error code: "
                   << pCallback->m_EChatRoomEnterResponse << std::endl;
@@ -144,95 +164,122 @@ void Steam::OnLobbyChatUpdate(LobbyChatUpdate_t* pCallback) {
         std::cout << "[Network] " << userName << " lost connection."
                   << std::endl;
     }
+
+    // The owner keeps the slot table in step with who is in the lobby; the
+    // rest pick the change up from OnLobbyDataUpdate. Ownership may have
+    // moved too, which changes who the host is.
+    if (SteamMatchmaking()->GetLobbyOwner(m_CurrentLobbyID) ==
+        SteamUser()->GetSteamID())
+        assignSlots();
+    else
+        readSlots();
 }
 
-void Steam::SendPosition(glm::vec3 pos, float yaw, float pitch) {
-    if (!m_CurrentLobbyID.IsValid())
+void Steam::OnLobbyDataUpdate(LobbyDataUpdate_t* pCallback) {
+    // Member data changes don't concern the slot table
+    if (pCallback->m_ulSteamIDLobby != m_CurrentLobbyID.ConvertToUint64() ||
+        pCallback->m_ulSteamIDMember != pCallback->m_ulSteamIDLobby)
         return;
 
-    PlayerPositionPacket packet;
-    packet.steamID = SteamUser()->GetSteamID().ConvertToUint64();
-    packet.x = pos.x;
-    packet.y = pos.y;
-    packet.z = pos.z;
-    packet.bodyYaw = yaw;
-    packet.headPitch = pitch;
+    readSlots();
+}
 
+void Steam::assignSlots() {
+    // Free the slots of anyone who has left
+    std::vector<uint64_t> members;
     int numMembers = SteamMatchmaking()->GetNumLobbyMembers(m_CurrentLobbyID);
     for (int i = 0; i < numMembers; i++) {
-        CSteamID target =
-            SteamMatchmaking()->GetLobbyMemberByIndex(m_CurrentLobbyID, i);
-        if (target == SteamUser()->GetSteamID())
-            continue; // Don't send to ourselves
-
-        SteamNetworkingIdentity identity;
-        identity.SetSteamID(target);
-
-        SteamNetworkingMessages()->SendMessageToUser(
-            identity,
-            &packet,
-            sizeof(packet),
-            k_nSteamNetworkingSend_Unreliable,
-            0);
+        members.push_back(
+            SteamMatchmaking()
+                ->GetLobbyMemberByIndex(m_CurrentLobbyID, i)
+                .ConvertToUint64());
+    }
+
+    std::vector<uint64_t> slots(MAX_SESSION_PLAYERS, 0);
+    for (int slot = 0; slot < MAX_SESSION_PLAYERS; slot++) {
+        const char* value =
+            SteamMatchmaking()->GetLobbyData(m_CurrentLobbyID,
+                                             slotKey(slot).c_str());
+        uint64_t id = value[0] ? std::strtoull(value, nullptr, 10) : 0;
+        if (id != 0 &&
+            std::find(members.begin(), members.end(), id) == members.end()) {
+            SteamMatchmaking()->SetLobbyData(
+                m_CurrentLobbyID, slotKey(slot).c_str(), "");
+            id = 0;
+        }
+        slots[slot] = id;
+    }
+
+    // Newcomers get the lowest free slot
+    for (uint64_t member : members) {
+        if (std::find(slots.begin(), slots.end(), member) != slots.end())
+            continue;
+
+        auto freeSlot = std::find(slots.begin(), slots.end(), 0);
+        if (freeSlot == slots.end()) {
+            std::cerr << "[Network] No free player slot for " << member
+                      << std::endl;
+            continue;
+        }
+        *freeSlot = member;
+        int slot = (int)(freeSlot - slots.begin());
+        SteamMatchmaking()->SetLobbyData(m_CurrentLobbyID,
+                                         slotKey(slot).c_str(),
+                                         std::to_string(member).c_str());
     }
+
+    readSlots();
 }
 
-void Steam::ReceivePackets() {
-    SteamNetworkingMessage_t* pIncomingMsg = nullptr;
-    while (SteamNetworkingMessages()->ReceiveMessagesOnChannel(
-               0, &pIncomingMsg, 1) > 0) {
-        if (pIncomingMsg) {
-            PacketType* type = (PacketType*)pIncomingMsg->m_pData;
-            if (*type == PacketType::PlayerPosition) {
-                PlayerPositionPacket* p =
-                    (PlayerPositionPacket*)pIncomingMsg->m_pData;
-
-                // Initialize currentPos if this is a new player
-                if (RemotePlayers.find(p->steamID) == RemotePlayers.end()) {
-                    RemotePlayers[p->steamID].currentPos =
-                        glm::vec3(p->x, p->y, p->z);
-                }
-
-                // Update the TARGET position, not the current position
-                RemotePlayers[p->steamID].targetPos =
-                    glm::vec3(p->x, p->y, p->z);
-
-                // Update rotation data
-                RemotePlayers[p->steamID].yaw = p->bodyYaw;
-                RemotePlayers[p->steamID].pitch = p->headPitch;
-
-                // Increment packet counter for tickrate calculation
-                s_PacketsReceivedThisSecond++;
-            }
-            pIncomingMsg->Release();
+void Steam::readSlots() {
+    uint64_t localID = SteamUser()->GetSteamID().ConvertToUint64();
+    for (int slot = 0; slot < MAX_SESSION_PLAYERS; slot++) {
+        const char* value =
+            SteamMatchmaking()->GetLobbyData(m_CurrentLobbyID,
+                                             slotKey(slot).c_str());
+        if (!value[0]) {
+            NetworkSession::ReleaseSlot((uint8_t)slot);
+            continue;
         }
+
+        uint64_t id = std::strtoull(value, nullptr, 10);
+        NetworkSession::AssignSlot((uint8_t)slot, id);
+        if (id == localID)
+            NetworkSession::SetLocalSlot((uint8_t)slot);
     }
+
+    // The lobby owner hosts
+    int host = NetworkSession::FindSlot(
+        SteamMatchmaking()->GetLobbyOwner(m_CurrentLobbyID).ConvertToUint64());
+    NetworkSession::SetHostSlot(host >= 0 ? (uint8_t)host : NO_PLAYER_SLOT);
 }
 
-int Steam::GetAndResetPacketCount() {
-    int count = s_PacketsReceivedThisSecond;
-    s_PacketsReceivedThisSecond = 0;
-    return count;
+void Steam::SendPosition(glm::vec3 pos, float yaw, float pitch) {
+    if (!m_CurrentLobbyID.IsValid())
+        return;
+
+    // Inputs to the host, or a snapshot to each client if we are the host
+    NetworkSession::SetLocalState(pos, yaw, pitch);
+    NetworkSession::SendTick();
 }
 
-void Steam::InterpolatePlayers(float deltaTime) {
-    // 10.0f is the "Smoothing Factor". Higher = faster response, Lower =
-    // smoother but laggier.
-    float lerpFactor = 10.0f * deltaTime;
+void Steam::ReceivePackets() {
+    ORIX_PROFILE_ZONE("Steam::ReceivePackets");
+    [[maybe_unused]] uint64_t start = Profiler::Now();
+
+    // SteamTransport pulls them a batch at a time
+    int received = NetworkSession::Receive();
 
-    for (auto& [id, data] : RemotePlayers) {
-        // Move currentPos slightly toward targetPos
-        data.currentPos = glm::mix(data.currentPos, data.targetPos, lerpFactor);
-        data.yaw = glm::mix(data.yaw, data.targetYaw, lerpFactor);
-        data.pitch = glm::mix(data.pitch, data.targetPitch, lerpFactor);
-    }
+    ORIX_PROFILE_COUNTER("Packets Received", received);
+    ORIX_PROFILE_COUNTER("Receive us",
+                         (int64_t)(Profiler::Now() - start) / 1000);
 }
 
 int Steam::GetPing(uint64_t targetID) {
     SteamNetConnectionRealTimeStatus_t status;
 
     SteamNetworkingIdentity identity;
-    identity.SetSteamID(CSteamID(targetID));
+    identity.SetSteamID(CSteamID((uint64)targetID));
 
     SteamNetworkingMessages()->GetSessionConnectionInfo(
         identity, nullptr, &status);
@@ -318,6 +365,9 @@ void Steam::OnLobbyMatchList(LobbyMatchList_t* pCallback, bool bIOFailure) {
 }
 
 void Steam::Shutdown() {
+    NetworkSession::SetTransport(nullptr);
+    NetworkSession::Reset();
+
     if (s_Instance) {
         delete s_Instance;
         s_Instance = nullptr;
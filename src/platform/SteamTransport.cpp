@@ -0,0 +1,61 @@
+#include "platform/SteamTransport.hpp"
+#include "game/network/NetworkSession.hpp"
+#include "steam/steamnetworkingtypes.h"
+
+#include <algorithm>
+
+SteamTransport::~SteamTransport() {
+    release();
+}
+
+void SteamTransport::Send(uint8_t slot, const void* data, size_t size) {
+    uint64_t player = NetworkSession::GetSlotPlayer(slot);
+    if (player == 0)
+        return;
+
+    SteamNetworkingIdentity identity;
+    identity.SetSteamID64(player);
+
+    // NetworkSession already coalesced the tick into one batch, so Steam's
+    // own Nagle delay would only add latency
+    SteamNetworkingMessages()->SendMessageToUser(
+        identity,
+        data,
+        (uint32)size,
+        k_nSteamNetworkingSend_UnreliableNoNagle,
+        0);
+}
+
+bool SteamTransport::Receive(TransportMessage& message) {
+    if (m_Next == m_Count) {
+        // A short batch means the queue was empty when it was taken, so
+        // asking again this frame would only cost another call
+        bool drained = m_Count > 0 && m_Count < RECEIVE_BATCH_SIZE;
+        release();
+        if (drained)
+            return false;
+
+        m_Count = std::max(0,
+                           SteamNetworkingMessages()->ReceiveMessagesOnChannel(
+                               0, m_Batch, RECEIVE_BATCH_SIZE));
+        if (m_Count == 0)
+            return false;
+    }
+
+    SteamNetworkingMessage_t* received = m_Batch[m_Next++];
+    message.data = received->m_pData;
+    message.size = (size_t)received->m_cbSize;
+
+    // Steam vouches for who sent it; the slot table says which slot that is
+    uint64_t player = received->m_identityPeer.GetSteamID64();
+    int slot = NetworkSession::FindSlot(player);
+    message.sender = slot < 0 ? NO_PLAYER_SLOT : (uint8_t)slot;
+    return true;
+}
+
+void SteamTransport::release() {
+    for (int i = 0; i < m_Count; i++)
+        m_Batch[i]->Release();
+    m_Count = 0;
+    m_Next = 0;
+}
@@ -0,0 +1,429 @@
+#include "platform/UdpTransport.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+#ifdef _WIN32
+using SocketHandle = SOCKET;
+using AddressLength = int;
+#else
+using SocketHandle = int;
+using AddressLength = socklen_t;
+#endif
+
+// First byte of every datagram
+enum class UdpMessage : uint8_t {
+    Hello = 1, // Client to host: magic, player ID
+    Welcome,   // Host to client: its slot, the host's slot
+    Goodbye,
+    Data, // A session message follows
+};
+
+const uint32_t UDP_MAGIC = 0x5544524F; // "ORDU" in file order
+const size_t HELLO_BYTES = 1 + 4 + 8;
+const size_t WELCOME_BYTES = 1 + 2;
+
+const double HELLO_INTERVAL = 0.25;
+const double PEER_TIMEOUT = 5.0;
+
+// A host with a full lobby takes a burst of datagrams every tick
+const int HOST_RECEIVE_BUFFER = 1 << 20;
+
+// Room for one batch and the kind byte
+const size_t MAX_DATAGRAM_BYTES = 2048;
+
+double now() {
+    using Clock = std::chrono::steady_clock;
+    return std::chrono::duration<double>(Clock::now().time_since_epoch())
+        .count();
+}
+
+uint64_t addressKey(uint32_t address, uint16_t port) {
+    return (uint64_t)address << 16 | port;
+}
+
+void closeSocket(intptr_t socket) {
+#ifdef _WIN32
+    closesocket((SocketHandle)socket);
+#else
+    close((SocketHandle)socket);
+#endif
+}
+
+// Winsock has to be started once per process before any socket call
+bool startSockets() {
+#ifdef _WIN32
+    static bool started = [] {
+        WSADATA data;
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }();
+    return started;
+#else
+    return true;
+#endif
+}
+
+} // namespace
+
+UdpTransport::UdpTransport() {
+    m_ReceiveBuffer.resize(MAX_DATAGRAM_BYTES);
+}
+
+UdpTransport::~UdpTransport() {
+    Close();
+}
+
+bool UdpTransport::open(uint16_t port) {
+    Close();
+    if (!startSockets()) {
+        std::cerr << "[Udp] Could not start Winsock" << std::endl;
+        return false;
+    }
+
+    SocketHandle handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#ifdef _WIN32
+    if (handle == INVALID_SOCKET) {
+#else
+    if (handle < 0) {
+#endif
+        std::cerr << "[Udp] Could not create a socket" << std::endl;
+        return false;
+    }
+    m_Socket = (intptr_t)handle;
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    if (bind(handle, (const sockaddr*)&address, sizeof(address)) != 0) {
+        std::cerr << "[Udp] Could not bind port " << port << std::endl;
+        Close();
+        return false;
+    }
+
+#ifdef _WIN32
+    u_long nonBlocking = 1;
+    ioctlsocket(handle, FIONBIO, &nonBlocking);
+#else
+    fcntl(handle, F_SETFL, fcntl(handle, F_GETFL, 0) | O_NONBLOCK);
+#endif
+    return true;
+}
+
+bool UdpTransport::Listen(uint16_t port, uint8_t hostSlot) {
+    if (!open(port))
+        return false;
+
+    int size = HOST_RECEIVE_BUFFER;
+    setsockopt((SocketHandle)m_Socket,
+               SOL_SOCKET,
+               SO_RCVBUF,
+               (const char*)&size,
+               sizeof(size));
+
+    m_IsHost = true;
+    m_LocalSlot = hostSlot;
+    m_HostSlot = hostSlot;
+    std::cout << "[Udp] Listening on port " << port << std::endl;
+    return true;
+}
+
+bool UdpTransport::Connect(const std::string& host,
+                           uint16_t port,
+                           uint64_t playerID) {
+    if (!open(0))
+        return false;
+
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0 || !result) {
+        std::cerr << "[Udp] Could not resolve " << host << std::endl;
+        Close();
+        return false;
+    }
+
+    const sockaddr_in* resolved = (const sockaddr_in*)result->ai_addr;
+    m_Server = Peer();
+    m_Server.address = ntohl(resolved->sin_addr.s_addr);
+    m_Server.port = port;
+    freeaddrinfo(result);
+
+    m_IsHost = false;
+    m_PlayerID = playerID;
+    m_LastHello = -std::numeric_limits<double>::infinity();
+    update();
+    return true;
+}
+
+void UdpTransport::Close() {
+    if (m_Socket < 0)
+        return;
+
+    // Saves the other end waiting out the timeout
+    if (m_IsHost) {
+        for (int slot = 0; slot < MAX_SESSION_PLAYERS; slot++) {
+            if (m_Peers[slot].active)
+                sendTo(m_Peers[slot], (uint8_t)UdpMessage::Goodbye, nullptr, 0);
+            m_Peers[slot] = Peer();
+        }
+        m_SlotByAddress.clear();
+    } else if (IsConnected()) {
+        sendTo(m_Server, (uint8_t)UdpMessage::Goodbye, nullptr, 0);
+    }
+
+    closeSocket(m_Socket);
+    m_Socket = -1;
+    m_IsHost = false;
+    m_LocalSlot = NO_PLAYER_SLOT;
+    m_HostSlot = NO_PLAYER_SLOT;
+    m_Events.clear();
+    m_EventCursor = 0;
+}
+
+void UdpTransport::Send(uint8_t slot, const void* data, size_t size) {
+    if (m_Socket < 0)
+        return;
+
+    if (m_IsHost) {
+        if (slot < MAX_SESSION_PLAYERS && m_Peers[slot].active)
+            sendTo(m_Peers[slot], (uint8_t)UdpMessage::Data, data, size);
+    } else if (IsConnected() && slot == m_HostSlot) {
+        sendTo(m_Server, (uint8_t)UdpMessage::Data, data, size);
+    }
+}
+
+void UdpTransport::sendTo(const Peer& peer,
+                          uint8_t kind,
+                          const void* data,
+                          size_t size) {
+    m_SendBuffer.resize(1 + size);
+    m_SendBuffer[0] = kind;
+    if (size > 0)
+        std::memcpy(m_SendBuffer.data() + 1, data, size);
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(peer.address);
+    address.sin_port = htons(peer.port);
+
+    // Unreliable anyway: a full send buffer is just another lost packet
+    sendto((SocketHandle)m_Socket,
+           (const char*)m_SendBuffer.data(),
+           (int)m_SendBuffer.size(),
+           0,
+           (const sockaddr*)&address,
+           sizeof(address));
+}
+
+bool UdpTransport::Receive(TransportMessage& message) {
+    while (m_Socket >= 0) {
+        sockaddr_in address = {};
+        AddressLength length = sizeof(address);
+        int received = (int)recvfrom((SocketHandle)m_Socket,
+                                     (char*)m_ReceiveBuffer.data(),
+                                     (int)m_ReceiveBuffer.size(),
+                                     0,
+                                     (sockaddr*)&address,
+                                     &length);
+        if (received < 0) {
+#ifdef _WIN32
+            // An earlier send bounced off a closed port; nothing to do
+            // with this read
+            if (WSAGetLastError() == WSAECONNRESET)
+                continue;
+#endif
+            break; // Nothing waiting, or a real error
+        }
+        if (received < 1)
+            continue;
+
+        Peer from;
+        from.address = ntohl(address.sin_addr.s_addr);
+        from.port = ntohs(address.sin_port);
+        const uint8_t* data = m_ReceiveBuffer.data();
+        if (data[0] != (uint8_t)UdpMessage::Data) {
+            handleControl(from, data, (size_t)received);
+            continue;
+        }
+
+        // Session traffic only from whoever we are talking to
+        Peer* sender = nullptr;
+        uint8_t senderSlot = NO_PLAYER_SLOT;
+        if (m_IsHost) {
+            auto found =
+                m_SlotByAddress.find(addressKey(from.address, from.port));
+            if (found != m_SlotByAddress.end()) {
+                sender = &m_Peers[found->second];
+                senderSlot = found->second;
+            }
+        } else if (IsConnected() && from.address == m_Server.address &&
+                   from.port == m_Server.port) {
+            sender = &m_Server;
+            senderSlot = m_HostSlot;
+        }
+        if (!sender)
+            continue;
+
+        sender->lastHeard = now();
+        message.data = data + 1;
+        message.size = (size_t)received - 1;
+        message.sender = senderSlot;
+        return true;
+    }
+
+    update();
+    return false;
+}
+
+void UdpTransport::handleControl(const Peer& from,
+                                 const uint8_t* data,
+                                 size_t size) {
+    UdpMessage kind = (UdpMessage)data[0];
+    uint64_t key = addressKey(from.address, from.port);
+
+    if (m_IsHost) {
+        auto found = m_SlotByAddress.find(key);
+        if (kind == UdpMessage::Hello && size >= HELLO_BYTES) {
+            uint32_t magic = 0;
+            uint64_t playerID = 0;
+            std::memcpy(&magic, data + 1, sizeof(magic));
+            std::memcpy(&playerID, data + 5, sizeof(playerID));
+            // An ID of 0 would read as an empty slot
+            if (magic != UDP_MAGIC || playerID == 0)
+                return;
+
+            // Already in: our welcome was lost, so say it again
+            if (found != m_SlotByAddress.end()) {
+                uint8_t welcome[2] = {found->second, m_HostSlot};
+                sendTo(m_Peers[found->second],
+                       (uint8_t)UdpMessage::Welcome,
+                       welcome,
+                       sizeof(welcome));
+                return;
+            }
+            accept(from, playerID);
+        } else if (kind == UdpMessage::Goodbye &&
+                   found != m_SlotByAddress.end()) {
+            drop(found->second);
+        }
+        return;
+    }
+
+    if (from.address != m_Server.address || from.port != m_Server.port)
+        return;
+
+    if (kind == UdpMessage::Welcome && size >= WELCOME_BYTES &&
+        !IsConnected()) {
+        m_LocalSlot = data[1];
+        m_HostSlot = data[2];
+        m_Server.lastHeard = now();
+        if (m_LocalSlot >= MAX_SESSION_PLAYERS ||
+            m_HostSlot >= MAX_SESSION_PLAYERS) {
+            m_LocalSlot = NO_PLAYER_SLOT;
+            m_HostSlot = NO_PLAYER_SLOT;
+            return;
+        }
+        m_Events.push_back({true, m_LocalSlot, m_PlayerID});
+    } else if (kind == UdpMessage::Goodbye && IsConnected()) {
+        disconnect();
+    }
+}
+
+void UdpTransport::accept(const Peer& from, uint64_t playerID) {
+    int slot = -1;
+    for (int candidate = 0; candidate < MAX_SESSION_PLAYERS; candidate++) {
+        if (candidate != m_HostSlot && !m_Peers[candidate].active) {
+            slot = candidate;
+            break;
+        }
+    }
+    if (slot < 0) {
+        // No answer; the client keeps asking until a slot frees up
+        return;
+    }
+
+    Peer& peer = m_Peers[slot];
+    peer = from;
+    peer.active = true;
+    peer.playerID = playerID;
+    peer.lastHeard = now();
+    m_SlotByAddress[addressKey(from.address, from.port)] = (uint8_t)slot;
+    m_Events.push_back({true, (uint8_t)slot, playerID});
+
+    uint8_t welcome[2] = {(uint8_t)slot, m_HostSlot};
+    sendTo(peer, (uint8_t)UdpMessage::Welcome, welcome, sizeof(welcome));
+}
+
+void UdpTransport::drop(uint8_t slot) {
+    Peer& peer = m_Peers[slot];
+    m_SlotByAddress.erase(addressKey(peer.address, peer.port));
+    m_Events.push_back({false, slot, peer.playerID});
+    peer = Peer();
+}
+
+void UdpTransport::disconnect() {
+    m_Events.push_back({false, m_LocalSlot, m_PlayerID});
+    m_LocalSlot = NO_PLAYER_SLOT;
+    m_HostSlot = NO_PLAYER_SLOT;
+}
+
+void UdpTransport::update() {
+    if (m_Socket < 0)
+        return;
+
+    double time = now();
+    if (m_IsHost) {
+        for (int slot = 0; slot < MAX_SESSION_PLAYERS; slot++) {
+            if (m_Peers[slot].active &&
+                time - m_Peers[slot].lastHeard > PEER_TIMEOUT)
+                drop((uint8_t)slot);
+        }
+        return;
+    }
+
+    if (IsConnected()) {
+        if (time - m_Server.lastHeard > PEER_TIMEOUT)
+            disconnect();
+        return;
+    }
+
+    // Keep asking; the host may not be up yet, or the hello got lost
+    if (time - m_LastHello >= HELLO_INTERVAL) {
+        uint8_t hello[HELLO_BYTES - 1];
+        std::memcpy(hello, &UDP_MAGIC, sizeof(UDP_MAGIC));
+        std::memcpy(hello + 4, &m_PlayerID, sizeof(m_PlayerID));
+        sendTo(m_Server, (uint8_t)UdpMessage::Hello, hello, sizeof(hello));
+        m_LastHello = time;
+    }
+}
+
+bool UdpTransport::PollEvent(UdpConnectionEvent& event) {
+    if (m_EventCursor >= m_Events.size()) {
+        m_Events.clear();
+        m_EventCursor = 0;
+        return false;
+    }
+    event = m_Events[m_EventCursor++];
+    return true;
+}
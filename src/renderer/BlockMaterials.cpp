@@ -0,0 +1,156 @@
+#include "renderer/BlockMaterials.hpp"
+#include <glad/glad.h>
+#include <vector>
+
+namespace {
+
+// Cheap integer hash so every texel gets a stable bit of noise
+float texelNoise(uint32_t layer, uint32_t x, uint32_t y) {
+    uint32_t h = layer * 374761393u + x * 668265263u + y * 2147483647u;
+    h = (h ^ (h >> 13)) * 1274126177u;
+    h ^= h >> 16;
+    return (float)(h & 0xFF) / 255.0f;
+}
+
+glm::vec3 texelColor(BlockTexture layer, int x, int y) {
+    const glm::vec3 grass(0.1f, 0.8f, 0.2f);
+    const glm::vec3 dirt(0.6f, 0.4f, 0.2f);
+    const glm::vec3 stone(0.5f, 0.5f, 0.5f);
+    const glm::vec3 lamp(1.0f, 0.85f, 0.5f);
+
+    glm::vec3 base;
+    switch (layer) {
+        case BlockTexture::GrassTop:
+            base = grass;
+            break;
+        case BlockTexture::GrassSide:
+            // Top rows are grass, the rest shows the dirt underneath
+            base = (y >= BLOCK_TEXTURE_SIZE - 3) ? grass : dirt;
+            break;
+        case BlockTexture::Dirt:
+            base = dirt;
+            break;
+        case BlockTexture::Lamp:
+            base = lamp;
+            break;
+        case BlockTexture::Stone:
+        default:
+            base = stone;
+            break;
+    }
+
+    float n = texelNoise((uint32_t)layer, x, y);
+    return base * (0.85f + 0.15f * n);
+}
+
+} // namespace
+
+BlockMaterials::BlockMaterials() {}
+
+BlockMaterials::~BlockMaterials() {
+    Release();
+}
+
+void BlockMaterials::Release() {
+    if (m_TextureArray)
+        glDeleteTextures(1, &m_TextureArray);
+    if (m_MaterialSSBO)
+        glDeleteBuffers(1, &m_MaterialSSBO);
+    m_TextureArray = 0;
+    m_MaterialSSBO = 0;
+}
+
+void BlockMaterials::Init() {
+    createTextureArray();
+    createMaterialBuffer();
+}
+
+void BlockMaterials::Bind() const {
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_TextureArray);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_MaterialSSBO);
+}
+
+void BlockMaterials::createTextureArray() {
+    const int size = BLOCK_TEXTURE_SIZE;
+    std::vector<uint8_t> pixels(size * size * 4 * BLOCK_TEXTURE_COUNT);
+
+    for (int layer = 0; layer < BLOCK_TEXTURE_COUNT; layer++) {
+        for (int y = 0; y < size; y++) {
+            for (int x = 0; x < size; x++) {
+                glm::vec3 c = texelColor((BlockTexture)layer, x, y);
+                size_t i = ((size_t)layer * size * size + y * size + x) * 4;
+                pixels[i + 0] = (uint8_t)(c.r * 255.0f);
+                pixels[i + 1] = (uint8_t)(c.g * 255.0f);
+                pixels[i + 2] = (uint8_t)(c.b * 255.0f);
+                pixels[i + 3] = 255;
+            }
+        }
+    }
+
+    glGenTextures(1, &m_TextureArray);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, m_TextureArray);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY,
+                 0,
+                 GL_RGBA8,
+                 size,
+                 size,
+                 BLOCK_TEXTURE_COUNT,
+                 0,
+                 GL_RGBA,
+                 GL_UNSIGNED_BYTE,
+                 pixels.data());
+
+    // Pixel-art look: nearest filtering, mips only for distant minification
+    glTexParameteri(
+        GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void BlockMaterials::createMaterialBuffer() {
+    auto layers = [](BlockMaterial& m,
+                     BlockTexture side,
+                     BlockTexture bottom,
+                     BlockTexture top) {
+        for (int face = 0; face < 4; face++)
+            m.faceLayers[face] = (uint32_t)side;
+        m.faceLayers[4] = (uint32_t)bottom;
+        m.faceLayers[5] = (uint32_t)top;
+    };
+
+    // Indexed directly by BlockType in the shader
+    BlockMaterial materials[BLOCK_TYPE_COUNT] = {};
+    for (auto& m : materials) {
+        m.tint = glm::vec4(1.0f);
+    }
+
+    layers(materials[(int)BlockType::Grass],
+           BlockTexture::GrassSide,
+           BlockTexture::Dirt,
+           BlockTexture::GrassTop);
+    layers(materials[(int)BlockType::Dirt],
+           BlockTexture::Dirt,
+           BlockTexture::Dirt,
+           BlockTexture::Dirt);
+    layers(materials[(int)BlockType::Stone],
+           BlockTexture::Stone,
+           BlockTexture::Stone,
+           BlockTexture::Stone);
+    layers(materials[(int)BlockType::Lamp],
+           BlockTexture::Lamp,
+           BlockTexture::Lamp,
+           BlockTexture::Lamp);
+
+    glGenBuffers(1, &m_MaterialSSBO);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_MaterialSSBO);
+    glBufferData(GL_SHADER_STORAGE_BUFFER,
+                 sizeof(materials),
+                 materials,
+                 GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
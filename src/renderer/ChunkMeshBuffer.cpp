@@ -0,0 +1,75 @@
+#include "renderer/ChunkMeshBuffer.hpp"
+#include "core/MemoryTracker.hpp"
+#include <glad/glad.h>
+
+ChunkMeshBuffer::~ChunkMeshBuffer() {
+    Release();
+}
+
+void ChunkMeshBuffer::Upload(const ChunkVertex* vertices, size_t count) {
+    m_VertexCount = (int)count;
+
+    size_t bytes = count * sizeof(ChunkVertex);
+    MemoryTracker::Add(MemoryCategory::GpuBuffers,
+                       (int64_t)bytes - (int64_t)m_Bytes);
+    m_Bytes = bytes;
+
+    if (m_VAO == 0)
+        glGenVertexArrays(1, &m_VAO);
+    if (m_VBO == 0)
+        glGenBuffers(1, &m_VBO);
+
+    glBindVertexArray(m_VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glBufferData(GL_ARRAY_BUFFER,
+                 count * sizeof(ChunkVertex),
+                 vertices,
+                 GL_STATIC_DRAW);
+
+    // Position attribute (location 0)
+    glVertexAttribPointer(0,
+                          3,
+                          GL_FLOAT,
+                          GL_FALSE,
+                          sizeof(ChunkVertex),
+                          (void*)offsetof(ChunkVertex, x));
+    glEnableVertexAttribArray(0);
+
+    // Texture coordinate attribute (location 1)
+    glVertexAttribPointer(1,
+                          2,
+                          GL_FLOAT,
+                          GL_FALSE,
+                          sizeof(ChunkVertex),
+                          (void*)offsetof(ChunkVertex, u));
+    glEnableVertexAttribArray(1);
+
+    // Packed block ID / face / AO / light attribute (location 2), integer
+    glVertexAttribIPointer(2,
+                           1,
+                           GL_UNSIGNED_INT,
+                           sizeof(ChunkVertex),
+                           (void*)offsetof(ChunkVertex, data));
+    glEnableVertexAttribArray(2);
+}
+
+void ChunkMeshBuffer::Draw() const {
+    if (m_VertexCount == 0)
+        return;
+
+    glBindVertexArray(m_VAO);
+    glDrawArrays(GL_TRIANGLES, 0, m_VertexCount);
+}
+
+void ChunkMeshBuffer::Release() {
+    if (m_VAO)
+        glDeleteVertexArrays(1, &m_VAO);
+    if (m_VBO)
+        glDeleteBuffers(1, &m_VBO);
+    m_VAO = 0;
+    m_VBO = 0;
+    m_VertexCount = 0;
+
+    MemoryTracker::Remove(MemoryCategory::GpuBuffers, m_Bytes);
+    m_Bytes = 0;
+}
@@ -0,0 +1,35 @@
+#include "renderer/Frustum.hpp"
+
+Frustum::Frustum(const glm::mat4& viewProjection) {
+    // Gribb/Hartmann: each plane is the last row plus or minus another row
+    glm::vec4 rows[4];
+    for (int i = 0; i < 4; i++) {
+        rows[i] = glm::vec4(viewProjection[0][i],
+                            viewProjection[1][i],
+                            viewProjection[2][i],
+                            viewProjection[3][i]);
+    }
+
+    m_Planes[0] = rows[3] + rows[0]; // Left
+    m_Planes[1] = rows[3] - rows[0]; // Right
+    m_Planes[2] = rows[3] + rows[1]; // Bottom
+    m_Planes[3] = rows[3] - rows[1]; // Top
+    m_Planes[4] = rows[3] + rows[2]; // Near
+    m_Planes[5] = rows[3] - rows[2]; // Far
+
+    for (auto& plane : m_Planes) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+}
+
+bool Frustum::IsBoxVisible(glm::vec3 min, glm::vec3 max) const {
+    for (const auto& plane : m_Planes) {
+        // Corner of the box furthest along the plane normal
+        glm::vec3 p(plane.x > 0.0f ? max.x : min.x,
+                    plane.y > 0.0f ? max.y : min.y,
+                    plane.z > 0.0f ? max.z : min.z);
+        if (glm::dot(glm::vec3(plane), p) + plane.w < 0.0f)
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,142 @@
+#include "renderer/GpuProfiler.hpp"
+#include "core/TraceCapture.hpp"
+#include <glad/glad.h>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+GpuProfiler::FrameQueries GpuProfiler::m_Frames[GpuProfiler::FRAME_LATENCY];
+
+void GpuProfiler::BeginFrame() {
+    if (!m_Initialized) {
+        for (auto& frame : m_Frames)
+            glGenQueries(MAX_ZONES * 2, frame.queries);
+        m_Initialized = true;
+    }
+
+    m_FrameNumber++;
+    m_FrameIndex = (m_FrameIndex + 1) % FRAME_LATENCY;
+
+    // This slot was last filled FRAME_LATENCY frames ago
+    FrameQueries& frame = m_Frames[m_FrameIndex];
+    resolve(frame);
+
+    frame.zoneCount = 0;
+    frame.lastQuery = -1;
+    frame.frameNumber = m_FrameNumber;
+}
+
+void GpuProfiler::resolve(FrameQueries& frame) {
+    if (frame.zoneCount == 0 || frame.lastQuery < 0)
+        return;
+
+    // Timestamps land in order, so if the last one is done they all are
+    GLint available = 0;
+    glGetQueryObjectiv(frame.queries[frame.lastQuery],
+                       GL_QUERY_RESULT_AVAILABLE,
+                       &available);
+    if (!available) {
+        m_DroppedFrames++;
+        return;
+    }
+
+    m_LastResults.clear();
+    GLuint64 firstBegin = 0;
+    for (int i = 0; i < frame.zoneCount; i++) {
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(frame.queries[i * 2], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(frame.queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+        double ms = end > begin ? (end - begin) / 1e6 : 0.0;
+
+        // The GPU clock isn't the CPU clock; traces pin the first pass to
+        // when the CPU issued it and keep the GPU spacing from there
+        if (i == 0)
+            firstBegin = begin;
+        if (TraceCapture::IsCapturing() && end > begin) {
+            uint64_t start = frame.cpuStart + (begin - firstBegin);
+            TraceCapture::RecordGpuZone(
+                frame.names[i], start, start + (end - begin));
+        }
+
+        // Zones opened more than once per frame are summed
+        bool merged = false;
+        for (auto& result : m_LastResults) {
+            if (std::strcmp(result.name, frame.names[i]) == 0) {
+                result.ms += ms;
+                merged = true;
+            }
+        }
+        if (!merged)
+            m_LastResults.push_back({frame.names[i], ms});
+    }
+
+    for (const auto& result : m_LastResults) {
+        auto it = m_Averages.find(result.name);
+        if (it == m_Averages.end())
+            m_Averages[result.name] = result.ms;
+        else
+            it->second += (result.ms - it->second) * 0.05;
+    }
+
+    m_History.push_back({frame.frameNumber, m_LastResults});
+    if (m_History.size() > HISTORY_FRAMES)
+        m_History.pop_front();
+}
+
+int GpuProfiler::BeginZone(const char* name) {
+    if (!m_Initialized)
+        return -1;
+
+    FrameQueries& frame = m_Frames[m_FrameIndex];
+    if (frame.zoneCount >= MAX_ZONES)
+        return -1;
+
+    int zone = frame.zoneCount++;
+    frame.names[zone] = name;
+    if (zone == 0)
+        frame.cpuStart = Profiler::Now();
+    glQueryCounter(frame.queries[zone * 2], GL_TIMESTAMP);
+    frame.lastQuery = zone * 2;
+    return zone;
+}
+
+void GpuProfiler::EndZone(int zone) {
+    if (zone < 0)
+        return;
+
+    FrameQueries& frame = m_Frames[m_FrameIndex];
+    glQueryCounter(frame.queries[zone * 2 + 1], GL_TIMESTAMP);
+    frame.lastQuery = zone * 2 + 1;
+}
+
+void GpuProfiler::Shutdown() {
+    if (!m_Initialized)
+        return;
+
+    for (auto& frame : m_Frames) {
+        glDeleteQueries(MAX_ZONES * 2, frame.queries);
+        frame.zoneCount = 0;
+        frame.lastQuery = -1;
+    }
+    m_Initialized = false;
+}
+
+bool GpuProfiler::ExportCsv(const std::string& path) {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "[GpuProfiler] Failed to open " << path << std::endl;
+        return false;
+    }
+
+    file << "frame,zone,ms\n";
+    for (const auto& frame : m_History) {
+        for (const auto& zone : frame.zones)
+            file << frame.frameNumber << "," << zone.name << "," << zone.ms
+                 << "\n";
+    }
+
+    std::cout << "[GpuProfiler] Wrote " << m_History.size() << " frames to "
+              << path << std::endl;
+    return true;
+}
@@ -0,0 +1,291 @@
+#include "renderer/LodTerrain.hpp"
+#include "core/FrameArena.hpp"
+#include "core/MemoryTracker.hpp"
+#include "core/Profiler.hpp"
+#include "game/World.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// A node splits while the camera is closer than this many tile widths
+const float LOD_SPLIT_FACTOR = 2.0f;
+
+// Skirt length in cells of the tile's own level
+const int LOD_SKIRT_DEPTH = 2;
+
+// Keep far tiles from crowding out edit remeshes on the shared workers
+const int MAX_LOD_REQUESTS_PER_FRAME = 4;
+const int MAX_LOD_JOBS_IN_FLIGHT = 8;
+
+// Cap GL uploads per frame so a burst of tiles can't cause a spike
+const size_t MAX_LOD_UPLOADS_PER_FRAME = 8;
+
+// Tiles that haven't been selected for this many frames are freed
+const uint64_t LOD_TILE_LIFETIME = 600;
+} // namespace
+
+LodTerrain::LodTerrain(const TerrainGenerator& terrain) : m_Terrain(terrain) {
+    // Far tiles are the cheapest VRAM to give back: they rebuild from the
+    // generator on demand
+    m_EvictionHook = MemoryTracker::AddEvictionHook(
+        MemoryCategory::GpuBuffers, [this](int64_t) { m_OverBudget = true; });
+}
+
+LodTerrain::~LodTerrain() {
+    MemoryTracker::RemoveEvictionHook(m_EvictionHook);
+}
+
+void LodTerrain::Release() {
+    // Finished jobs only land on tiles that still exist, so none will
+    m_MeshQueue.Flush();
+    m_Tiles.clear();
+    m_Selected.clear();
+    m_JobsInFlight = 0;
+}
+
+void LodTerrain::Update() {
+    m_FinishedMeshes.clear();
+    m_MeshQueue.CollectResults(m_FinishedMeshes, MAX_LOD_UPLOADS_PER_FRAME);
+
+    for (MeshJob* job : m_FinishedMeshes) {
+        applyMesh(job->mesh);
+        m_MeshQueue.Recycle(job);
+    }
+    ORIX_PROFILE_COUNTER("LOD Tiles Meshed", (int)m_FinishedMeshes.size());
+}
+
+glm::ivec3 LodTerrain::tileKey(glm::ivec3 origin, int level) {
+    return glm::ivec3(origin.x, level, origin.z);
+}
+
+int LodTerrain::tileSize(int level) {
+    return CHUNK_SIZE << level;
+}
+
+LodTerrain::LodTile& LodTerrain::getTile(glm::ivec3 origin, int level) {
+    auto& tile = m_Tiles[tileKey(origin, level)];
+    if (!tile)
+        tile = std::make_unique<LodTile>();
+    tile->lastUsedFrame = m_Frame;
+    return *tile;
+}
+
+bool LodTerrain::hasLoadedChunks(World& world, glm::ivec3 origin) {
+    // Level 1 tiles cover 2x2 chunk columns
+    for (int x = 0; x < 2; x++) {
+        for (int z = 0; z < 2; z++) {
+            glm::ivec3 chunk = origin + glm::ivec3(x, 0, z) * CHUNK_SIZE;
+            if (world.GetChunk(chunk))
+                return true;
+        }
+    }
+    return false;
+}
+
+bool LodTerrain::isReady(glm::ivec3 origin, int level) {
+    LodTile& tile = getTile(origin, level);
+    if (!tile.meshed)
+        requestMesh(origin, level, tile);
+    return tile.meshed;
+}
+
+void LodTerrain::Select(World& world,
+                        glm::vec3 cameraPos,
+                        const Frustum& frustum) {
+    m_Frame++;
+    m_RequestsThisFrame = 0;
+    m_Selected.clear();
+    evictUnused();
+
+    // Roots are the coarsest tiles inside the horizon, nearest first so
+    // the ground around the player fills in before the skyline
+    int rootSize = tileSize(LOD_LEVEL_COUNT);
+    int radius = (int)std::ceil(LOD_HORIZON / rootSize) + 1;
+    glm::ivec3 center(
+        (int)std::floor(cameraPos.x / rootSize) * rootSize,
+        0,
+        (int)std::floor(cameraPos.z / rootSize) * rootSize);
+
+    FrameVector<glm::ivec3> roots;
+    for (int x = -radius; x <= radius; x++) {
+        for (int z = -radius; z <= radius; z++) {
+            roots.push_back(center + glm::ivec3(x, 0, z) * rootSize);
+        }
+    }
+    auto distanceTo = [&](glm::ivec3 origin) {
+        glm::vec2 mid = glm::vec2(origin.x, origin.z) + rootSize * 0.5f;
+        return glm::length(mid - glm::vec2(cameraPos.x, cameraPos.z));
+    };
+    std::sort(roots.begin(), roots.end(), [&](glm::ivec3 a, glm::ivec3 b) {
+        return distanceTo(a) < distanceTo(b);
+    });
+
+    for (glm::ivec3 root : roots) {
+        selectNode(world, root, LOD_LEVEL_COUNT, cameraPos, frustum);
+    }
+}
+
+void LodTerrain::selectNode(World& world,
+                            glm::ivec3 origin,
+                            int level,
+                            glm::vec3 cameraPos,
+                            const Frustum& frustum) {
+    int size = tileSize(level);
+    float scale = (float)(1 << level);
+
+    // Blocks are centred on integer coordinates, hence the half offsets
+    glm::vec3 boundsMin = glm::vec3(origin) - 0.5f;
+    boundsMin.y = -LOD_SKIRT_DEPTH * scale - 0.5f;
+    glm::vec3 boundsMax = glm::vec3(origin) + (float)size - 0.5f;
+
+    glm::vec3 closest = glm::clamp(cameraPos, boundsMin, boundsMax);
+    float distance = glm::length(cameraPos - closest);
+    if (distance > LOD_HORIZON)
+        return;
+    if (!frustum.IsBoxVisible(boundsMin, boundsMax))
+        return;
+
+    // Loaded chunks replace the finest tiles outright
+    if (level == 1 && hasLoadedChunks(world, origin))
+        return;
+
+    if (level > 1 && distance < size * LOD_SPLIT_FACTOR) {
+        // Only split once every child can be drawn, otherwise keep showing
+        // this tile while the children are built
+        int half = size / 2;
+        bool childrenReady = true;
+        for (int x = 0; x < 2; x++) {
+            for (int z = 0; z < 2; z++) {
+                glm::ivec3 child = origin + glm::ivec3(x, 0, z) * half;
+                bool ready = (level - 1 == 1 && hasLoadedChunks(world, child))
+                                 ? true
+                                 : isReady(child, level - 1);
+                childrenReady = childrenReady && ready;
+            }
+        }
+
+        if (childrenReady) {
+            for (int x = 0; x < 2; x++) {
+                for (int z = 0; z < 2; z++) {
+                    glm::ivec3 child = origin + glm::ivec3(x, 0, z) * half;
+                    selectNode(world, child, level - 1, cameraPos, frustum);
+                }
+            }
+            return;
+        }
+    }
+
+    LodTile& tile = getTile(origin, level);
+    if (!tile.meshed) {
+        requestMesh(origin, level, tile);
+        return;
+    }
+    m_Selected.push_back({origin, level, &tile});
+}
+
+void LodTerrain::Render(Shader& shader) {
+    m_TrianglesDrawn = 0;
+
+    for (const SelectedTile& selected : m_Selected) {
+        // Cells are meshed at unit size around integer centres; scale them
+        // up and shift so cell edges land on block edges
+        float scale = (float)(1 << selected.level);
+        glm::vec3 offset = glm::vec3(selected.origin) + (scale * 0.5f - 0.5f);
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), offset);
+        model = glm::scale(model, glm::vec3(scale));
+        shader.SetMat4("u_Model", model);
+
+        selected.tile->mesh.Draw();
+        m_TrianglesDrawn += selected.tile->mesh.GetVertexCount() / 3;
+    }
+}
+
+void LodTerrain::requestMesh(glm::ivec3 origin, int level, LodTile& tile) {
+    if (tile.pending || m_RequestsThisFrame >= MAX_LOD_REQUESTS_PER_FRAME ||
+        m_JobsInFlight >= MAX_LOD_JOBS_IN_FLIGHT)
+        return;
+
+    MeshJob* job = m_MeshQueue.Acquire();
+    job->mode = Chunk::s_MeshMode;
+    job->mesh.origin = origin;
+    job->mesh.lodLevel = level;
+    job->mesh.skirtDepth = LOD_SKIRT_DEPTH;
+    job->mesh.sectionMask = ALL_CHUNK_SECTIONS;
+    gatherTile(origin, level, job->blocks);
+
+    tile.pending = true;
+    m_JobsInFlight++;
+    m_RequestsThisFrame++;
+    m_MeshQueue.Submit(job);
+}
+
+void LodTerrain::gatherTile(glm::ivec3 origin,
+                            int level,
+                            ChunkNeighbourhood& out) {
+    int scale = 1 << level;
+
+    // One height sample per cell column, taken at the cell centre
+    for (int x = -1; x <= CHUNK_SIZE; x++) {
+        for (int z = -1; z <= CHUNK_SIZE; z++) {
+            int height = m_Terrain.GetHeight(origin.x + x * scale + scale / 2,
+                                             origin.z + z * scale + scale / 2);
+
+            for (int y = -1; y <= CHUNK_SIZE; y++) {
+                int bottom = y * scale;
+                int top = bottom + scale;
+
+                // Cells below the world count as solid so the never-seen
+                // underside isn't meshed
+                BlockType type = BlockType::Stone;
+                if (y >= 0) {
+                    // A cell is solid if the column covers its centre, and
+                    // shows the highest block inside it so grass stays on top
+                    type = height > bottom + scale / 2
+                               ? TerrainGenerator::GetBlockInColumn(
+                                     std::min(top, height) - 1, height)
+                               : BlockType::Air;
+                }
+
+                out.blocks[x + 1][y + 1][z + 1] = type;
+                out.light[x + 1][y + 1][z + 1] = MAX_LIGHT_LEVEL << 4;
+            }
+        }
+    }
+}
+
+void LodTerrain::applyMesh(ChunkMeshData& data) {
+    auto it = m_Tiles.find(tileKey(data.origin, data.lodLevel));
+    if (it == m_Tiles.end())
+        return;
+
+    LodTile& tile = *it->second;
+    tile.pending = false;
+    m_JobsInFlight--;
+
+    size_t total = 0;
+    for (const auto& section : data.sections)
+        total += section.size();
+
+    FrameVector<ChunkVertex> vertices;
+    vertices.reserve(total);
+    for (const auto& section : data.sections)
+        vertices.insert(vertices.end(), section.begin(), section.end());
+
+    tile.mesh.Upload(vertices.data(), vertices.size());
+    tile.meshed = true;
+}
+
+void LodTerrain::evictUnused() {
+    // Over the GPU budget, tiles only live while they're being drawn
+    uint64_t lifetime = m_OverBudget ? 1 : LOD_TILE_LIFETIME;
+    m_OverBudget = false;
+
+    for (auto it = m_Tiles.begin(); it != m_Tiles.end();) {
+        LodTile& tile = *it->second;
+        if (!tile.pending && m_Frame - tile.lastUsedFrame > lifetime)
+            it = m_Tiles.erase(it);
+        else
+            ++it;
+    }
+}
@@ -0,0 +1,318 @@
+#include "renderer/WorldRenderer.hpp"
+#include "core/FrameArena.hpp"
+#include "core/Profiler.hpp"
+#include "game/World.hpp"
+#include "game/network/RemotePlayerStore.hpp"
+#include "renderer/Frustum.hpp"
+#include "renderer/GpuProfiler.hpp"
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+WorldRenderer::WorldRenderer(World& world)
+    : m_World(world), m_Lod(world.GetTerrain()) {}
+
+void WorldRenderer::Init() {
+    m_Materials.Init();
+    InitPlayerCube();
+    m_PlayerShader =
+        std::make_unique<Shader>("shaders/player.vert", "shaders/player.frag");
+}
+
+void WorldRenderer::Shutdown() {
+    m_ChunkMeshes.clear();
+    m_Lod.Release();
+    m_Materials.Release();
+
+    if (m_PlayerCubeVAO)
+        glDeleteVertexArrays(1, &m_PlayerCubeVAO);
+    if (m_PlayerCubeVBO)
+        glDeleteBuffers(1, &m_PlayerCubeVBO);
+    m_PlayerCubeVAO = 0;
+    m_PlayerCubeVBO = 0;
+
+    if (m_PlayerShader)
+        glDeleteProgram(m_PlayerShader->ID);
+    m_PlayerShader.reset();
+}
+
+void WorldRenderer::releaseUnloadedMeshes() {
+    ChunkPool& pool = m_World.GetChunkPool();
+    for (auto it = m_ChunkMeshes.begin(); it != m_ChunkMeshes.end();) {
+        if (pool.Get(it->second->chunk)) {
+            ++it;
+            continue;
+        }
+
+        // Give the VAO/VBO back now rather than whenever the map is next
+        // cleaned up
+        it->second->buffer.Release();
+        it = m_ChunkMeshes.erase(it);
+    }
+}
+
+void WorldRenderer::uploadChangedMeshes() {
+    m_World.GetChunkPool().ForEach([&](ChunkHandle handle, Chunk& chunk) {
+        auto& mesh = m_ChunkMeshes[chunk.GetWorldPos()];
+        if (!mesh)
+            mesh = std::make_unique<ChunkGpuMesh>();
+
+        // A chunk reloaded at the same origin is a new handle, whatever its
+        // mesh version says
+        if (mesh->chunk == handle && mesh->version == chunk.GetMeshVersion())
+            return;
+
+        // Sections are kept apart on the CPU so edits only remesh a slab;
+        // the GPU gets them back to back in one buffer
+        FrameVector<ChunkVertex> vertices;
+        vertices.reserve(chunk.GetVertexCount());
+        for (int s = 0; s < CHUNK_SECTION_COUNT; s++) {
+            const auto& section = chunk.GetSection(s);
+            vertices.insert(vertices.end(), section.begin(), section.end());
+        }
+
+        mesh->buffer.Upload(vertices.data(), vertices.size());
+        mesh->chunk = handle;
+        mesh->version = chunk.GetMeshVersion();
+    });
+}
+
+void WorldRenderer::Render(Shader& shader,
+                           const Camera& camera,
+                           int width,
+                           int height) {
+    ORIX_PROFILE_ZONE("WorldRenderer::Render");
+
+    releaseUnloadedMeshes();
+    uploadChangedMeshes();
+    m_Lod.Update();
+
+    shader.Use();
+    glm::mat4 view = camera.GetViewMatrix();
+    glm::mat4 projection =
+        camera.GetProjectionMatrix((float)width, (float)height);
+
+    // We send View and Projection once. Model is sent per chunk.
+    glm::mat4 viewProjection = projection * view;
+    shader.SetMat4("u_VP", viewProjection);
+    Frustum frustum(viewProjection);
+
+    {
+        ORIX_GPU_ZONE("World");
+
+        // Materials are bound once for all chunks
+        m_Materials.Bind();
+
+        m_RenderStats = WorldRenderStats();
+        for (auto const& [pos, mesh] : m_ChunkMeshes) {
+            glm::vec3 boundsMin = glm::vec3(pos) - 0.5f;
+            glm::vec3 boundsMax = boundsMin + (float)CHUNK_SIZE;
+            if (mesh->buffer.GetVertexCount() == 0 ||
+                !frustum.IsBoxVisible(boundsMin, boundsMax))
+                continue;
+
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(pos));
+            shader.SetMat4("u_Model", model);
+            mesh->buffer.Draw();
+
+            m_RenderStats.chunksDrawn++;
+            m_RenderStats.triangles += mesh->buffer.GetVertexCount() / 3;
+        }
+
+        // Far terrain fills in everywhere the loaded chunks don't reach
+        m_Lod.Select(m_World, camera.GetPosition(), frustum);
+        m_Lod.Render(shader);
+        m_RenderStats.lodTilesDrawn = m_Lod.GetTilesDrawn();
+        m_RenderStats.triangles += m_Lod.GetTrianglesDrawn();
+    }
+
+    // Body and head per remote player
+    m_RenderStats.drawCalls = m_RenderStats.chunksDrawn +
+                              m_RenderStats.lodTilesDrawn +
+                              RemotePlayerStore::GetCount() * 2;
+    ORIX_PROFILE_COUNTER("Draw Calls", m_RenderStats.drawCalls);
+    ORIX_PROFILE_COUNTER("Triangles", m_RenderStats.triangles);
+
+    ORIX_GPU_ZONE("Remote Players");
+
+    // Bind the player cube VAO for rendering remote players
+    m_PlayerShader->Use();
+    m_PlayerShader->SetMat4("u_VP", viewProjection);
+    glBindVertexArray(m_PlayerCubeVAO);
+
+    // Render remote players
+    const std::vector<glm::vec3>& positions = RemotePlayerStore::GetPositions();
+    const std::vector<float>& yaws = RemotePlayerStore::GetYaws();
+    const std::vector<float>& pitches = RemotePlayerStore::GetPitches();
+    for (int i = 0; i < RemotePlayerStore::GetCount(); i++) {
+        // Render body (rectangular box that rotates with yaw)
+        glm::mat4 bodyModel = glm::mat4(1.0f);
+        bodyModel = glm::translate(bodyModel, positions[i]);
+        bodyModel = glm::translate(
+            bodyModel,
+            glm::vec3(0.0f, 0.6f, 0.0f)); // Lift body so bottom is at feet
+        bodyModel = glm::rotate(
+            bodyModel, glm::radians(-(yaws[i] - 90.0f)), glm::vec3(0, 1, 0));
+        bodyModel = glm::scale(bodyModel, glm::vec3(0.6f, 1.2f, 0.4f));
+
+        m_PlayerShader->SetMat4("u_Model", bodyModel);
+        m_PlayerShader->SetVec3("u_Color", glm::vec3(0.2f, 0.4f, 1.0f));
+        glDrawArrays(GL_TRIANGLES, 0, 36);
+
+        // Render head (cube positioned above body, rotates with yaw and tilts
+        // with pitch)
+        glm::mat4 headModel = glm::mat4(1.0f);
+        headModel = glm::translate(headModel, positions[i]);
+        headModel = glm::translate(
+            headModel,
+            glm::vec3(
+                0.0f,
+                1.6f,
+                0.0f)); // Position head above body (body height 1.2 + 0.4)
+        headModel = glm::rotate(headModel,
+                                glm::radians(-(yaws[i] - 90.0f)),
+                                glm::vec3(0, 1, 0)); // Rotate with body
+        headModel = glm::rotate(headModel,
+                                glm::radians(-pitches[i]),
+                                glm::vec3(1, 0, 0)); // Tilt up/down
+        headModel = glm::scale(headModel, glm::vec3(0.4f, 0.4f, 0.4f));
+
+        m_PlayerShader->SetMat4("u_Model", headModel);
+        m_PlayerShader->SetVec3("u_Color", glm::vec3(1.0f, 0.8f, 0.6f));
+        glDrawArrays(GL_TRIANGLES, 0, 36);
+    }
+
+    // Unbind VAO
+    glBindVertexArray(0);
+}
+
+void WorldRenderer::InitPlayerCube() {
+    // Simple cube vertices (position only, 36 vertices for 6 faces)
+    float vertices[] = {// Back face
+                        -0.5f,
+                        -0.5f,
+                        -0.5f,
+                        0.5f,
+                        -0.5f,
+                        -0.5f,
+                        0.5f,
+                        0.5f,
+                        -0.5f,
+                        0.5f,
+                        0.5f,
+                        -0.5f,
+                        -0.5f,
+                        0.5f,
+                        -0.5f,
+                        -0.5f,
+                        -0.5f,
+                        -0.5f,
+                        // Front face
+                        -0.5f,
+                        -0.5f,
+                        0.5f,
+                        0.5f,
+                        -0.5f,
+                        0.5f,
+                        0.5f,
+                        0.5f,
+                        0.5f,
+                        0.5f,
+                        0.5f,
+                        0.5f,
+                        -0.5f,
+                        0.5f,
+                        0.5f,
+                        -0.5f,
+                        -0.5f,
+                        0.5f,
+                        // Left face
+                        -0.5f,
+                        0.5f,
+                        0.5f,
+                        -0.5f,
+                        0.5f,
+                        -0.5f,
+                        -0.5f,
+                        -0.5f,
+                        -0.5f,
+                        -0.5f,
+                        -0.5f,
+                        -0.5f,
+                        -0.5f,
+                        -0.5f,
+                        0.5f,
+                        -0.5f,
+                        0.5f,
+                        0.5f,
+                        // Right face
+                        0.5f,
+                        0.5f,
+                        0.5f,
+                        0.5f,
+                        0.5f,
+                        -0.5f,
+                        0.5f,
+                        -0.5f,
+                        -0.5f,
+                        0.5f,
+                        -0.5f,
+                        -0.5f,
+                        0.5f,
+                        -0.5f,
+                        0.5f,
+                        0.5f,
+                        0.5f,
+                        0.5f,
+                        // Bottom face
+                        -0.5f,
+                        -0.5f,
+                        -0.5f,
+                        0.5f,
+                        -0.5f,
+                        -0.5f,
+                        0.5f,
+                        -0.5f,
+                        0.5f,
+                        0.5f,
+                        -0.5f,
+                        0.5f,
+                        -0.5f,
+                        -0.5f,
+                        0.5f,
+                        -0.5f,
+                        -0.5f,
+                        -0.5f,
+                        // Top face
+                        -0.5f,
+                        0.5f,
+                        -0.5f,
+                        0.5f,
+                        0.5f,
+                        -0.5f,
+                        0.5f,
+                        0.5f,
+                        0.5f,
+                        0.5f,
+                        0.5f,
+                        0.5f,
+                        -0.5f,
+                        0.5f,
+                        0.5f,
+                        -0.5f,
+                        0.5f,
+                        -0.5f};
+
+    glGenVertexArrays(1, &m_PlayerCubeVAO);
+    glGenBuffers(1, &m_PlayerCubeVBO);
+
+    glBindVertexArray(m_PlayerCubeVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_PlayerCubeVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+    // Position attribute (location 0)
+    glVertexAttribPointer(
+        0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glBindVertexArray(0);
+}
\ No newline at end of file
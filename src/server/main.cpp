@@ -0,0 +1,10 @@
+#include "core/CommandLine.hpp"
+#include "core/HeadlessApplication.hpp"
+
+// Dedicated server: always headless, never touches SDL, GL or Steam
+int main(int argc, char **argv) {
+    CommandLine::Parse(argc, argv);
+
+    HeadlessApplication server;
+    return server.Run();
+}
\ No newline at end of file
@@ -1,9 +1,13 @@
 #include "states/PlayState.hpp"
 #include "core/Application.hpp"
+#include "core/Input.hpp"
+#include "game/network/NetworkSession.hpp"
+#include "game/network/RemotePlayerStore.hpp"
 #include "platform/Steam.hpp"
 #include "ui/UIManager.hpp"
 #include "imgui.h"
 
+#include <cmath>
 #include <iostream>
 
 void PlayState::OnEnter(Application* app) {
@@ -14,29 +18,93 @@ void PlayState::OnExit(Application* app) {
     app->SetMouseLocked(false);
 }
 
+void PlayState::FixedUpdate(float step, Application* app) {
+    // Physics only ever sees the fixed step. Our own movement is predicted
+    // from inputs the host will check; as the host, we check everyone's.
+    NetworkSession::GetPrediction().Step(
+        app->GetPlayer(), app->GetWorld(), readPlayerInput(), step);
+    NetworkSession::SimulateClients(app->GetWorld(), step);
+
+    // Network tick
+    const float tickInterval = 1.0f / app->GetNetworkTickrate();
+
+    m_NetworkTimer += step;
+    if (m_NetworkTimer >= tickInterval) {
+        auto& player = app->GetPlayer();
+        Steam::SendPosition(player.Position, player.Yaw, player.Pitch);
+        m_NetworkTimer -= tickInterval;
+    }
+}
+
 void PlayState::Update(float deltaTime, Application* app) {
     // std::cout << "[PlayState] Update" << std::endl; // Too spammy
     // Steam updates
     Steam::ReceivePackets();
-    Steam::InterpolatePlayers(deltaTime);
+    RemotePlayerStore::Interpolate(deltaTime);
 
-    // Player/World updates
-    app->GetPlayer().Update(deltaTime, app->GetWorld());
+    // Mouse look and edits stay per frame so they never lag or repeat
+    if (app->IsMouseLocked()) {
+        app->GetPlayer().UpdateCameraRotation(Input::GetMouseDelta());
+    }
+
+    // Camera sits between the last two physics states
+    app->GetPlayer().Interpolate(app->GetInterpolationAlpha());
 
     if (app->IsMouseLocked()) {
-        app->GetPlayer().UpdateCameraRotation(deltaTime);
+        HandleBlockInteraction(app);
     }
 
-    // Network tick
-    static float networkTimer = 0.0f;
-    const float tickInterval = 1.0f / app->GetNetworkTickrate();
+    // Remesh everything edited this frame in one batch
+    app->GetWorld().Update(deltaTime);
+}
 
-    networkTimer += deltaTime;
-    if (networkTimer >= tickInterval) {
-        auto& player = app->GetPlayer();
-        Steam::SendPosition(player.Position, player.Yaw, player.Pitch);
-        networkTimer = 0.0f;
+PlayerInput PlayState::readPlayerInput() const {
+    PlayerInput input;
+    input.forward = Input::IsKeyDown(SDL_SCANCODE_W);
+    input.backward = Input::IsKeyDown(SDL_SCANCODE_S);
+    input.left = Input::IsKeyDown(SDL_SCANCODE_A);
+    input.right = Input::IsKeyDown(SDL_SCANCODE_D);
+    input.jump = Input::IsKeyDown(SDL_SCANCODE_SPACE);
+    return input;
+}
+
+void PlayState::HandleBlockInteraction(Application* app) {
+    // Number keys pick the block to place
+    const SDL_Scancode keys[] = {
+        SDL_SCANCODE_1, SDL_SCANCODE_2, SDL_SCANCODE_3, SDL_SCANCODE_4};
+    for (int i = 0; i < 4; i++) {
+        if (Input::IsKeyPressed(keys[i]))
+            m_SelectedBlock = (BlockType)(i + 1);
+    }
+
+    bool breakBlock = Input::IsMouseButtonPressed(SDL_BUTTON_LEFT);
+    bool placeBlock = Input::IsMouseButtonPressed(SDL_BUTTON_RIGHT);
+    if (!breakBlock && !placeBlock)
+        return;
+
+    auto& player = app->GetPlayer();
+    auto& camera = player.GetCamera();
+    auto& world = app->GetWorld();
+
+    glm::ivec3 hit, normal;
+    if (!world.Raycast(camera.Position, camera.Front, 6.0f, hit, normal))
+        return;
+
+    if (breakBlock) {
+        world.SetBlockAt(hit.x, hit.y, hit.z, BlockType::Air);
+        return;
     }
+
+    // Don't place a block inside the player's own body
+    glm::ivec3 target = hit + normal;
+    glm::ivec3 feet((int)floor(player.Position.x),
+                    (int)floor(player.Position.y),
+                    (int)floor(player.Position.z));
+    if (target.x == feet.x && target.z == feet.z && target.y >= feet.y &&
+        target.y <= (int)floor(player.Position.y + player.Height))
+        return;
+
+    world.SetBlockAt(target.x, target.y, target.z, m_SelectedBlock);
 }
 
 void PlayState::Render(Application* app) {
@@ -45,10 +113,10 @@ void PlayState::Render(Application* app) {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     // Render World
-    app->GetWorld().Render(app->GetShader(),
-                           app->GetPlayer().GetCamera(),
-                           app->GetWidth(),
-                           app->GetHeight());
+    app->GetWorldRenderer().Render(app->GetShader(),
+                                   app->GetPlayer().GetCamera(),
+                                   app->GetWidth(),
+                                   app->GetHeight());
 
     // In-Game UI (ImGui Debug)
     ImGui::SetNextWindowBgAlpha(
@@ -67,7 +135,18 @@ void PlayState::Render(Application* app) {
                     app->GetPlayer().Pitch,
                     app->GetPlayer().Yaw);
 
+        ImGui::Text("Selected Block: %d (1-4 to change)",
+                    (int)m_SelectedBlock);
+
+        const WorldRenderStats& stats =
+            app->GetWorldRenderer().GetRenderStats();
+        ImGui::Text("Chunks: %d, LOD tiles: %d",
+                    stats.chunksDrawn,
+                    stats.lodTilesDrawn);
+        ImGui::Text("Triangles: %d", stats.triangles);
+
         ImGui::Separator();
+        ImGui::Text("Simulation: %.0f Hz", app->GetSimulationRate());
         ImGui::Text("Network Tickrate: %.0f Hz", app->GetNetworkTickrate());
         ImGui::End();
     }
@@ -0,0 +1,65 @@
+#include "ui/MemoryWindow.hpp"
+#include "core/MemoryTracker.hpp"
+#include "imgui.h"
+
+namespace {
+float toMB(int64_t bytes) {
+    return bytes / (1024.0f * 1024.0f);
+}
+} // namespace
+
+void MemoryWindow::Draw(bool* open) {
+    ImGui::SetNextWindowSize(ImVec2(520, 260), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Memory", open)) {
+        ImGui::End();
+        return;
+    }
+
+    ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders;
+    if (ImGui::BeginTable("memory", 5, flags)) {
+        ImGui::TableSetupColumn("Category");
+        ImGui::TableSetupColumn("Current (MB)");
+        ImGui::TableSetupColumn("Peak (MB)");
+        ImGui::TableSetupColumn("Budget (MB)");
+        ImGui::TableSetupColumn("Used", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableHeadersRow();
+
+        for (int i = 0; i < MEMORY_CATEGORY_COUNT; i++) {
+            MemoryCategory category = (MemoryCategory)i;
+            int64_t current = MemoryTracker::GetCurrent(category);
+            int64_t budget = MemoryTracker::GetBudget(category);
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(MemoryTracker::GetName(category));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", toMB(current));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", toMB(MemoryTracker::GetPeak(category)));
+
+            // Budgets can be tuned live to try out the eviction hooks
+            ImGui::TableNextColumn();
+            ImGui::PushID(i);
+            int budgetMB = (int)(budget / (1024 * 1024));
+            ImGui::SetNextItemWidth(-1.0f);
+            if (ImGui::InputInt("##budget", &budgetMB, 16, 128) &&
+                budgetMB >= 0)
+                MemoryTracker::SetBudget(category,
+                                         (int64_t)budgetMB * 1024 * 1024);
+            ImGui::PopID();
+
+            ImGui::TableNextColumn();
+            float fraction = budget > 0 ? (float)current / budget : 1.0f;
+            if (fraction > 1.0f)
+                ImGui::PushStyleColor(ImGuiCol_PlotHistogram,
+                                      ImVec4(0.9f, 0.3f, 0.3f, 1.0f));
+            ImGui::ProgressBar(fraction > 1.0f ? 1.0f : fraction,
+                               ImVec2(-1.0f, 0.0f));
+            if (fraction > 1.0f)
+                ImGui::PopStyleColor();
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
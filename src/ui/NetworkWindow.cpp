@@ -0,0 +1,153 @@
+#include "ui/NetworkWindow.hpp"
+#include "game/network/NetworkSession.hpp"
+#include "game/network/NetworkStats.hpp"
+#include "game/network/RemotePlayerStore.hpp"
+#include "game/network/SimulatedTransport.hpp"
+#include "imgui.h"
+#include <cstdio>
+
+namespace {
+void row(const char* name, float sent, float received) {
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted(name);
+    ImGui::TableNextColumn();
+    ImGui::Text("%.0f", sent);
+    ImGui::TableNextColumn();
+    ImGui::Text("%.0f", received);
+}
+} // namespace
+
+void NetworkWindow::Draw(bool* open) {
+    ImGui::SetNextWindowSize(ImVec2(420, 560), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Network", open)) {
+        ImGui::End();
+        return;
+    }
+
+    const NetworkRates& rates = NetworkStats::GetRates();
+    int players = RemotePlayerStore::GetCount();
+    uint8_t localSlot = NetworkSession::GetLocalSlot();
+    if (localSlot == NO_PLAYER_SLOT)
+        ImGui::Text("No slot yet, %d remote players", players);
+    else
+        ImGui::Text("Slot %d (%s), %d remote players",
+                    localSlot,
+                    NetworkSession::IsHost() ? "host" : "client",
+                    players);
+
+    ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders;
+    if (ImGui::BeginTable("network", 3, flags)) {
+        ImGui::TableSetupColumn("Per second");
+        ImGui::TableSetupColumn("Sent");
+        ImGui::TableSetupColumn("Received");
+        ImGui::TableHeadersRow();
+
+        row("Bytes", rates.bytesSent, rates.bytesReceived);
+        row("Packets", rates.packetsSent, rates.packetsReceived);
+        row("Player states", rates.statesSent, rates.statesReceived);
+
+        // The host's traffic scales with the clients it serves, a client's
+        // with the players in each snapshot; either way, per remote player
+        float perPlayer = players > 0 ? 1.0f / players : 0.0f;
+        row("Bytes per player",
+            rates.bytesSent * perPlayer,
+            rates.bytesReceived * perPlayer);
+        row("Uncompressed per player",
+            rates.statesSent * UNCOMPRESSED_STATE_BYTES * perPlayer,
+            rates.statesReceived * UNCOMPRESSED_STATE_BYTES * perPlayer);
+        ImGui::EndTable();
+    }
+
+    // Remote players are drawn this far behind the newest state
+    ImGui::Separator();
+    ImGui::TextUnformatted("Interpolation");
+    int delayMs = (int)(RemotePlayerStore::GetInterpolationDelay() * 1000.0f);
+    if (ImGui::SliderInt("Delay (ms)", &delayMs, 0, 500))
+        RemotePlayerStore::SetInterpolationDelay(delayMs / 1000.0f);
+    ImGui::Text("Buffer depth: %.1f states",
+                RemotePlayerStore::GetAverageBufferDepth());
+    ImGui::Text("Extrapolating: %d players",
+                RemotePlayerStore::GetExtrapolatingCount());
+    ImGui::Text("Late states: %lld",
+                (long long)RemotePlayerStore::GetLateStates());
+
+    // Our own movement, run ahead of the host
+    ImGui::Separator();
+    ImGui::TextUnformatted("Prediction");
+    const PlayerPrediction& prediction = NetworkSession::GetPrediction();
+    ImGui::Text("Unconfirmed inputs: %d", prediction.GetUnacknowledged());
+    ImGui::Text("Corrections: %lld", (long long)prediction.GetCorrections());
+    ImGui::Text("Last correction: %.3f blocks", prediction.GetLastError());
+
+    drawConditions();
+
+    ImGui::End();
+}
+
+void NetworkWindow::drawConditions() {
+    auto* simulator =
+        dynamic_cast<SimulatedTransport*>(NetworkSession::GetTransport());
+    if (!simulator)
+        return;
+
+    ImGui::Separator();
+    ImGui::TextUnformatted("Simulated conditions");
+
+    // Everyone shares the default; a slot can be given its own instead
+    char preview[32] = "Everyone";
+    if (m_ConditionSlot >= 0)
+        std::snprintf(preview, sizeof(preview), "Slot %d", m_ConditionSlot);
+    if (ImGui::BeginCombo("Connection", preview)) {
+        if (ImGui::Selectable("Everyone", m_ConditionSlot < 0))
+            m_ConditionSlot = -1;
+        for (int slot = 0; slot < MAX_SESSION_PLAYERS; slot++) {
+            if (slot == NetworkSession::GetLocalSlot() ||
+                NetworkSession::GetSlotPlayer((uint8_t)slot) == 0)
+                continue;
+            char label[32];
+            std::snprintf(label,
+                          sizeof(label),
+                          simulator->HasConditions((uint8_t)slot)
+                              ? "Slot %d (own)"
+                              : "Slot %d",
+                          slot);
+            if (ImGui::Selectable(label, m_ConditionSlot == slot))
+                m_ConditionSlot = slot;
+        }
+        ImGui::EndCombo();
+    }
+
+    uint8_t slot = (uint8_t)m_ConditionSlot;
+    NetworkConditions conditions = m_ConditionSlot < 0
+                                       ? simulator->GetConditions()
+                                       : simulator->GetConditions(slot);
+    bool changed = false;
+    changed |= ImGui::SliderFloat(
+        "Latency (ms)", &conditions.latencyMs, 0.0f, 500.0f, "%.0f");
+    changed |= ImGui::SliderFloat(
+        "Jitter (ms)", &conditions.jitterMs, 0.0f, 200.0f, "%.0f");
+    changed |= ImGui::SliderFloat(
+        "Loss (%)", &conditions.lossPercent, 0.0f, 50.0f, "%.1f");
+    changed |= ImGui::SliderFloat(
+        "Duplicate (%)", &conditions.duplicatePercent, 0.0f, 50.0f, "%.1f");
+    changed |= ImGui::SliderFloat(
+        "Reorder (%)", &conditions.reorderPercent, 0.0f, 50.0f, "%.1f");
+    if (changed) {
+        if (m_ConditionSlot < 0)
+            simulator->SetConditions(conditions);
+        else
+            simulator->SetConditions(slot, conditions);
+    }
+    if (m_ConditionSlot >= 0 && simulator->HasConditions(slot) &&
+        ImGui::Button("Use everyone's"))
+        simulator->ClearConditions(slot);
+
+    const NetworkSimulationStats& stats = simulator->GetStats();
+    ImGui::Text("Sent %lld, dropped %lld, duplicated %lld, reordered %lld",
+                (long long)stats.sent,
+                (long long)stats.dropped,
+                (long long)stats.duplicated,
+                (long long)stats.reordered);
+    ImGui::Text("In flight: %d", stats.inFlight);
+}
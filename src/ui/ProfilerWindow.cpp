@@ -0,0 +1,215 @@
+#include "ui/ProfilerWindow.hpp"
+#include "core/Profiler.hpp"
+#include "renderer/GpuProfiler.hpp"
+#include "imgui.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+const float ROW_HEIGHT = 18.0f;
+
+// Stable colour per zone name so the same zone is easy to follow
+ImU32 zoneColor(const char* name) {
+    uint32_t hash = 2166136261u;
+    for (const char* c = name; *c; c++)
+        hash = (hash ^ (uint8_t)*c) * 16777619u;
+
+    float hue = (hash % 360) / 360.0f;
+    float r, g, b;
+    ImGui::ColorConvertHSVtoRGB(hue, 0.55f, 0.85f, r, g, b);
+    return ImGui::GetColorU32(ImVec4(r, g, b, 1.0f));
+}
+
+} // namespace
+
+void ProfilerWindow::Draw(bool* open) {
+    ImGui::SetNextWindowSize(ImVec2(640, 420), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("CPU Profiler", open)) {
+        ImGui::End();
+        return;
+    }
+
+    const ProfileFrame& frame = Profiler::GetLastFrame();
+    float frameMs = (frame.end - frame.start) / 1e6f;
+    ImGui::Text("Frame: %.2f ms", frameMs);
+
+    ImGui::SameLine();
+    bool paused = Profiler::IsPaused();
+    if (ImGui::Checkbox("Pause", &paused))
+        Profiler::SetPaused(paused);
+
+    ImGui::SameLine();
+    bool enabled = Profiler::IsEnabled();
+    if (ImGui::Checkbox("Enabled", &enabled))
+        Profiler::SetEnabled(enabled);
+
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::SliderFloat("Range (ms)", &m_TimelineRangeMs, 1.0f, 100.0f);
+
+    if (Profiler::GetDroppedEvents() > 0)
+        ImGui::TextColored(ImVec4(1, 0.4f, 0.4f, 1),
+                           "Dropped events: %llu",
+                           (unsigned long long)Profiler::GetDroppedEvents());
+
+    // Per-frame counters on one line
+    for (const auto& [name, value] : frame.counters) {
+        ImGui::Text("%s: %lld", name.c_str(), (long long)value);
+        ImGui::SameLine();
+    }
+    ImGui::NewLine();
+
+    drawTimeline();
+    ImGui::Separator();
+
+    // CPU zones and GPU passes side by side
+    if (ImGui::BeginTable("profilers", 2, ImGuiTableFlags_Resizable)) {
+        ImGui::TableNextColumn();
+        drawZoneTable();
+        ImGui::TableNextColumn();
+        drawGpuTable();
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+void ProfilerWindow::drawTimeline() {
+    const ProfileFrame& frame = Profiler::GetLastFrame();
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+    const float labelWidth = 90.0f;
+    float width = ImGui::GetContentRegionAvail().x - labelWidth;
+    float nsToPixels = width / (m_TimelineRangeMs * 1e6f);
+
+    for (const ProfileThreadCapture& thread : frame.threads) {
+        if (thread.events.empty())
+            continue;
+
+        uint32_t maxDepth = 0;
+        for (const ProfileEvent& event : thread.events)
+            maxDepth = std::max(maxDepth, event.depth);
+
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        float laneHeight = (maxDepth + 1) * ROW_HEIGHT;
+        ImGui::TextUnformatted(thread.threadName.c_str());
+
+        float x0 = origin.x + labelWidth;
+        for (const ProfileEvent& event : thread.events) {
+            // Zones from a worker can straddle the frame boundary
+            float start = (float)((int64_t)(event.start - frame.start));
+            float end = (float)((int64_t)(event.end - frame.start));
+            float left = x0 + std::max(start, 0.0f) * nsToPixels;
+            float right = x0 + std::min(end * nsToPixels, width);
+            if (right <= left)
+                continue;
+            right = std::max(right, left + 1.0f);
+
+            ImVec2 min(left, origin.y + event.depth * ROW_HEIGHT);
+            ImVec2 max(right, min.y + ROW_HEIGHT - 1.0f);
+            drawList->AddRectFilled(min, max, zoneColor(event.name));
+
+            // Only label zones wide enough to hold some text
+            if (right - left > 30.0f) {
+                drawList->PushClipRect(min, max, true);
+                drawList->AddText(ImVec2(min.x + 2.0f, min.y + 2.0f),
+                                  IM_COL32(20, 20, 20, 255),
+                                  event.name);
+                drawList->PopClipRect();
+            }
+
+            if (ImGui::IsMouseHoveringRect(min, max))
+                ImGui::SetTooltip("%s\n%.3f ms",
+                                  event.name,
+                                  (event.end - event.start) / 1e6);
+        }
+
+        ImGui::SetCursorScreenPos(ImVec2(origin.x, origin.y + laneHeight + 4));
+        ImGui::Dummy(ImVec2(1, 1));
+    }
+}
+
+void ProfilerWindow::drawZoneTable() {
+    const auto& stats = Profiler::GetZoneStats();
+
+    // Sorted by total time so the expensive zones are on top
+    std::vector<std::pair<const std::string*, const ZoneStats*>> rows;
+    for (auto const& [name, zone] : stats)
+        rows.push_back({&name, &zone});
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        return a.second->totalNs > b.second->totalNs;
+    });
+
+    ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders |
+                            ImGuiTableFlags_ScrollY;
+    if (!ImGui::BeginTable("zones", 6, flags))
+        return;
+
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Zone");
+    ImGui::TableSetupColumn("Calls");
+    ImGui::TableSetupColumn("Min (ms)");
+    ImGui::TableSetupColumn("Avg (ms)");
+    ImGui::TableSetupColumn("Max (ms)");
+    ImGui::TableSetupColumn("Allocs/call");
+    ImGui::TableHeadersRow();
+
+    for (auto const& [name, zone] : rows) {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(name->c_str());
+        ImGui::TableNextColumn();
+        ImGui::Text("%u", zone->calls);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", zone->minNs / 1e6);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", zone->AverageNs() / 1e6);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", zone->maxNs / 1e6);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", zone->AverageAllocations());
+    }
+
+    ImGui::EndTable();
+}
+
+void ProfilerWindow::drawGpuTable() {
+    double totalMs = 0.0;
+    for (const GpuZoneResult& result : GpuProfiler::GetLastResults())
+        totalMs += result.ms;
+    ImGui::Text("GPU passes: %.2f ms", totalMs);
+
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Export"))
+        GpuProfiler::ExportCsv("gpu_timings.csv");
+
+    if (GpuProfiler::GetDroppedFrames() > 0)
+        ImGui::TextDisabled("Late frames skipped: %llu",
+                            (unsigned long long)GpuProfiler::GetDroppedFrames());
+
+    if (!ImGui::BeginTable("gpu", 3, ImGuiTableFlags_RowBg |
+                                         ImGuiTableFlags_Borders))
+        return;
+
+    ImGui::TableSetupColumn("Pass");
+    ImGui::TableSetupColumn("Last (ms)");
+    ImGui::TableSetupColumn("Avg (ms)");
+    ImGui::TableHeadersRow();
+
+    const auto& averages = GpuProfiler::GetAverages();
+    for (const GpuZoneResult& result : GpuProfiler::GetLastResults()) {
+        auto it = averages.find(result.name);
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(result.name);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", result.ms);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", it != averages.end() ? it->second : 0.0);
+    }
+
+    ImGui::EndTable();
+}
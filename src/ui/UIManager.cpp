@@ -1,6 +1,10 @@
 #include "ui/UIManager.hpp"
+#include "core/MemoryTracker.hpp"
+#include "renderer/GpuProfiler.hpp"
 #include <RmlUi_Platform_SDL.h>
 #include <RmlUi_Renderer_GL3.h>
+#include <cstddef>
+#include <cstdlib>
 #include <iostream>
 #include "imgui.h"
 #include "imgui_impl_opengl3.h"
@@ -11,6 +15,29 @@
 #undef GetUserName
 #endif
 
+namespace {
+// ImGui allocations go through here so the memory window can show them.
+// The size is kept in front of each block for the free.
+const size_t UI_ALLOC_HEADER = alignof(std::max_align_t);
+
+void* uiAlloc(size_t size, void*) {
+    uint8_t* block = (uint8_t*)std::malloc(size + UI_ALLOC_HEADER);
+    if (!block)
+        return nullptr;
+    *(size_t*)block = size;
+    MemoryTracker::Add(MemoryCategory::UI, size);
+    return block + UI_ALLOC_HEADER;
+}
+
+void uiFree(void* ptr, void*) {
+    if (!ptr)
+        return;
+    uint8_t* block = (uint8_t*)ptr - UI_ALLOC_HEADER;
+    MemoryTracker::Remove(MemoryCategory::UI, *(size_t*)block);
+    std::free(block);
+}
+} // namespace
+
 UIManager::UIManager() {}
 
 UIManager::~UIManager() {
@@ -20,6 +47,7 @@ UIManager::~UIManager() {
 bool UIManager::Initialize(SDL_Window* window, int width, int height) {
     // ImGui Init
     IMGUI_CHECKVERSION();
+    ImGui::SetAllocatorFunctions(uiAlloc, uiFree);
     ImGui::CreateContext();
     ImGui_ImplSDL2_InitForOpenGL(window, SDL_GL_GetCurrentContext());
     ImGui_ImplOpenGL3_Init("#version 450");
@@ -107,14 +135,19 @@ void UIManager::BeginFrame() {
 
 void UIManager::EndFrame() {
     if (m_RmlRenderer) {
+        ORIX_GPU_ZONE("RmlUi");
         m_RmlRenderer->EndFrame();
     }
 
     ImGui::Render();
+
+    ORIX_GPU_ZONE("ImGui");
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 }
 
 void UIManager::Render() {
+    ORIX_GPU_ZONE("RmlUi");
+
     // Start RmlUi frame and render
     if (m_RmlRenderer) {
         m_RmlRenderer->BeginFrame();